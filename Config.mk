@@ -45,7 +45,7 @@
 # ASFLAGS         := # Assembly Flags
 # CFLAGS          := # C Flags
 CXXFLAGS        := -std=c++14 -O3 # -Wall -Wextra -Wshadow
-# LDFLAGS         := # Linker flags
+LDFLAGS         := -pthread # Linker flags
 
 # Documentation
 # ===============
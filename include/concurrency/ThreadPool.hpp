@@ -0,0 +1,76 @@
+/***********************************************************************/
+/*  Copyright 2016 ToPS                                                */
+/*                                                                     */
+/*  This program is free software; you can redistribute it and/or      */
+/*  modify it under the terms of the GNU  General Public License as    */
+/*  published by the Free Software Foundation; either version 3 of     */
+/*  the License, or (at your option) any later version.                */
+/*                                                                     */
+/*  This program is distributed in the hope that it will be useful,    */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of     */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the      */
+/*  GNU General Public License for more details.                       */
+/*                                                                     */
+/*  You should have received a copy of the GNU General Public License  */
+/*  along with this program; if not, write to the Free Software        */
+/*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,         */
+/*  MA 02110-1301, USA.                                                */
+/***********************************************************************/
+
+#ifndef CONCURRENCY_THREAD_POOL_
+#define CONCURRENCY_THREAD_POOL_
+
+// Standard headers
+#include <queue>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <condition_variable>
+
+namespace concurrency {
+
+/**
+ * @class ThreadPool
+ * @brief Fixed set of workers running fire-and-forget tasks
+ *
+ * Tasks may enqueue other tasks. wait() blocks until every task (including
+ * those enqueued while waiting) has finished, and rethrows the first
+ * exception thrown by any of them.
+ */
+class ThreadPool {
+ public:
+  // Constructors
+  explicit ThreadPool(std::size_t num_threads = 0);
+
+  // Concrete methods
+  void enqueue(std::function<void()> task);
+  void wait();
+
+  std::size_t size() const;
+
+  // Destructor
+  ~ThreadPool();
+
+ private:
+  // Instance variables
+  std::vector<std::thread> workers_;
+  std::queue<std::function<void()>> tasks_;
+
+  std::mutex mutex_;
+  std::condition_variable task_available_;
+  std::condition_variable tasks_done_;
+
+  std::size_t pending_;
+  std::exception_ptr error_;
+  bool stopping_;
+
+  // Concrete methods
+  void work();
+};
+
+}  // namespace concurrency
+
+#endif  // CONCURRENCY_THREAD_POOL_
@@ -0,0 +1,142 @@
+/***********************************************************************/
+/*  Copyright 2016 ToPS                                                */
+/*                                                                     */
+/*  This program is free software; you can redistribute it and/or      */
+/*  modify it under the terms of the GNU  General Public License as    */
+/*  published by the Free Software Foundation; either version 3 of     */
+/*  the License, or (at your option) any later version.                */
+/*                                                                     */
+/*  This program is distributed in the hope that it will be useful,    */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of     */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the      */
+/*  GNU General Public License for more details.                       */
+/*                                                                     */
+/*  You should have received a copy of the GNU General Public License  */
+/*  along with this program; if not, write to the Free Software        */
+/*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,         */
+/*  MA 02110-1301, USA.                                                */
+/***********************************************************************/
+
+#ifndef CONFIG_ARENA_
+#define CONFIG_ARENA_
+
+// Standard headers
+#include <memory>
+#include <vector>
+#include <cstddef>
+
+namespace config {
+
+// Forward declarations
+class Arena;
+
+/**
+ * @typedef ArenaPtr
+ * @brief Alias of pointer to Arena
+ */
+using ArenaPtr = std::shared_ptr<Arena>;
+
+/**
+ * @class Arena
+ * @brief Monotonic memory resource for the nodes of one config IR
+ *
+ * Memory is carved out of large blocks and never given back one object at
+ * a time: all blocks are released at once, when the arena is destroyed.
+ * Nodes made by config::makeShared while an Arena::Scope is active keep
+ * the arena alive, so it is released together with the last of them.
+ * An arena is only used by the thread in which its scope was opened.
+ */
+class Arena {
+ public:
+  // Inner classes
+  class Scope {
+   public:
+    // Constructors
+    Scope();  // Opens a new arena, unless one is already current
+    explicit Scope(ArenaPtr arena);  // Makes arena current in any case
+
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+
+    // Destructor
+    ~Scope();
+
+   private:
+    // Instance variables
+    ArenaPtr previous_;
+  };
+
+  // Constructors
+  explicit Arena(std::size_t block_size = 64 * 1024);
+
+  Arena(const Arena &) = delete;
+  Arena &operator=(const Arena &) = delete;
+
+  // Static methods
+  static const ArenaPtr &current();
+
+  // Concrete methods
+  void *allocate(std::size_t size, std::size_t alignment);
+
+  std::size_t allocated() const;  // Bytes requested from the system
+
+ private:
+  // Instance variables
+  std::vector<std::unique_ptr<char[]>> blocks_;
+  std::size_t block_size_;
+  std::size_t allocated_ = 0;
+
+  char *position_ = nullptr;
+  std::size_t available_ = 0;
+};
+
+/**
+ * @class ArenaAllocator
+ * @brief Allocator taking memory from a config::Arena
+ *
+ * Deallocation does nothing: memory is only released with the arena,
+ * which is kept alive by every copy of the allocator.
+ */
+template<typename T>
+class ArenaAllocator {
+ public:
+  // Alias
+  using value_type = T;
+
+  // Constructors
+  explicit ArenaAllocator(ArenaPtr arena);
+
+  template<typename U>
+  ArenaAllocator(const ArenaAllocator<U> &other);  // NOLINT(runtime/explicit)
+
+  // Concrete methods
+  T *allocate(std::size_t n);
+  void deallocate(T *pointer, std::size_t n);
+
+  const ArenaPtr &arena() const;
+
+ private:
+  // Instance variables
+  ArenaPtr arena_;
+};
+
+template<typename T, typename U>
+bool operator==(const ArenaAllocator<T> &lhs, const ArenaAllocator<U> &rhs);
+
+template<typename T, typename U>
+bool operator!=(const ArenaAllocator<T> &lhs, const ArenaAllocator<U> &rhs);
+
+/**
+ * @fn makeShared
+ * @brief Creates a node of the config IR in the current arena, if any,
+ * or as std::make_shared does otherwise
+ */
+template<typename T, typename... Args>
+std::shared_ptr<T> makeShared(Args&&... args);
+
+}  // namespace config
+
+// Implementation header
+#include "config/Arena.ipp"
+
+#endif  // CONFIG_ARENA_
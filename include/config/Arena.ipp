@@ -0,0 +1,95 @@
+/***********************************************************************/
+/*  Copyright 2016 ToPS                                                */
+/*                                                                     */
+/*  This program is free software; you can redistribute it and/or      */
+/*  modify it under the terms of the GNU  General Public License as    */
+/*  published by the Free Software Foundation; either version 3 of     */
+/*  the License, or (at your option) any later version.                */
+/*                                                                     */
+/*  This program is distributed in the hope that it will be useful,    */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of     */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the      */
+/*  GNU General Public License for more details.                       */
+/*                                                                     */
+/*  You should have received a copy of the GNU General Public License  */
+/*  along with this program; if not, write to the Free Software        */
+/*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,         */
+/*  MA 02110-1301, USA.                                                */
+/***********************************************************************/
+
+// Standard headers
+#include <memory>
+#include <cstddef>
+#include <utility>
+
+namespace config {
+
+/*----------------------------------------------------------------------------*/
+/*                                CONSTRUCTORS                                */
+/*----------------------------------------------------------------------------*/
+
+template<typename T>
+ArenaAllocator<T>::ArenaAllocator(ArenaPtr arena)
+    : arena_(std::move(arena)) {
+}
+
+/*----------------------------------------------------------------------------*/
+
+template<typename T>
+template<typename U>
+ArenaAllocator<T>::ArenaAllocator(const ArenaAllocator<U> &other)
+    : arena_(other.arena()) {
+}
+
+/*----------------------------------------------------------------------------*/
+/*                              CONCRETE METHODS                              */
+/*----------------------------------------------------------------------------*/
+
+template<typename T>
+T *ArenaAllocator<T>::allocate(std::size_t n) {
+  return static_cast<T *>(arena_->allocate(n * sizeof(T), alignof(T)));
+}
+
+/*----------------------------------------------------------------------------*/
+
+template<typename T>
+void ArenaAllocator<T>::deallocate(T * /* pointer */, std::size_t /* n */) {
+}
+
+/*----------------------------------------------------------------------------*/
+
+template<typename T>
+const ArenaPtr &ArenaAllocator<T>::arena() const {
+  return arena_;
+}
+
+/*----------------------------------------------------------------------------*/
+/*                                  FUNCTIONS                                 */
+/*----------------------------------------------------------------------------*/
+
+template<typename T, typename U>
+bool operator==(const ArenaAllocator<T> &lhs, const ArenaAllocator<U> &rhs) {
+  return lhs.arena() == rhs.arena();
+}
+
+/*----------------------------------------------------------------------------*/
+
+template<typename T, typename U>
+bool operator!=(const ArenaAllocator<T> &lhs, const ArenaAllocator<U> &rhs) {
+  return !(lhs == rhs);
+}
+
+/*----------------------------------------------------------------------------*/
+
+template<typename T, typename... Args>
+std::shared_ptr<T> makeShared(Args&&... args) {
+  auto &arena = Arena::current();
+  if (!arena) return std::make_shared<T>(std::forward<Args>(args)...);
+
+  return std::allocate_shared<T>(ArenaAllocator<T>(arena),
+                                 std::forward<Args>(args)...);
+}
+
+/*----------------------------------------------------------------------------*/
+
+}  // namespace config
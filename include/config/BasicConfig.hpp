@@ -29,6 +29,7 @@
 #include <type_traits>
 
 // Internal headers
+#include "config/Arena.hpp"
 #include "config/HasTag.hpp"
 #include "config/ParameterPack.hpp"
 #include "config/BasicConfigInterface.hpp"
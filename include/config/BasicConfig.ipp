@@ -46,7 +46,7 @@ template<typename Base, typename... Options>
 template<typename... Params>
 std::shared_ptr<BasicConfig<Base, Options...>>
 BasicConfig<Base, Options...>::make(Params&&... params) {
-  return std::make_shared<Self>(std::forward<Params>(params)...);
+  return makeShared<Self>(std::forward<Params>(params)...);
 }
 
 /*----------------------------------------------------------------------------*/
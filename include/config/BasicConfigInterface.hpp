@@ -25,6 +25,9 @@
 #include <string>
 #include <cstddef>
 
+// Internal headers
+#include "config/SymbolTable.hpp"
+
 namespace config {
 
 // Forward declarations
@@ -33,6 +36,9 @@ class ModelConfigVisitor;
 /**
  * @class BasicConfigInterface
  * Base class for config::BasicConfig hierarchy representing a config IR
+ *
+ * Each node keeps alive the config::SymbolTable that was current when it
+ * was made, in which its path, label and symbols are interned.
  */
 class BasicConfigInterface
     : public std::enable_shared_from_this<BasicConfigInterface> {
@@ -49,11 +55,8 @@ class BasicConfigInterface
   virtual void accept(ModelConfigVisitor &&/* visitor */) const = 0;
 
   // Virtual methods
-  virtual std::string path();
-  virtual const std::string path() const;
-
-  virtual std::string label();
-  virtual const std::string label() const;
+  virtual const std::string &path() const;
+  virtual const std::string &label() const;
 
   virtual std::size_t number_of_options() const;
 
@@ -71,8 +74,10 @@ class BasicConfigInterface
   virtual ~BasicConfigInterface() = default;
 
  private:
-  std::string path_;
-  std::string label_;
+  // Paths and labels repeat in many configs, so they are stored interned
+  SymbolTablePtr symbols_;
+  SymbolTable::Symbol path_;
+  SymbolTable::Symbol label_;
 };
 
 }  // namespace config
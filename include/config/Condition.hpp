@@ -0,0 +1,94 @@
+/***********************************************************************/
+/*  Copyright 2016 ToPS                                                */
+/*                                                                     */
+/*  This program is free software; you can redistribute it and/or      */
+/*  modify it under the terms of the GNU  General Public License as    */
+/*  published by the Free Software Foundation; either version 3 of     */
+/*  the License, or (at your option) any later version.                */
+/*                                                                     */
+/*  This program is distributed in the hope that it will be useful,    */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of     */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the      */
+/*  GNU General Public License for more details.                       */
+/*                                                                     */
+/*  You should have received a copy of the GNU General Public License  */
+/*  along with this program; if not, write to the Free Software        */
+/*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,         */
+/*  MA 02110-1301, USA.                                                */
+/***********************************************************************/
+
+#ifndef CONFIG_CONDITION_
+#define CONFIG_CONDITION_
+
+// Standard headers
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <functional>
+
+// Internal headers
+#include "config/SymbolTable.hpp"
+
+namespace config {
+
+/**
+ * @class Condition
+ * @brief Key of a table of (conditional) probabilities
+ *
+ * Represents `"target"` or `"target | context"`, where the context is a
+ * sequence of space-separated symbols. Symbols are interned in the current
+ * config::SymbolTable, so conditions are stored and compared as handles,
+ * and hashed from the hashes kept by the table. str() gives back the
+ * original text.
+ */
+class Condition {
+ public:
+  // Alias
+  using Symbol = SymbolTable::Symbol;
+
+  // Constructors
+  explicit Condition(const std::string &target);
+  Condition(const std::string &target, const std::string &context);
+  Condition(const char *target, std::size_t target_size,
+            const char *context, std::size_t context_size);
+
+  // Static methods
+  static Condition parse(const std::string &key);
+
+  // Concrete methods
+  Symbol target() const;
+  std::vector<Symbol> context() const;
+  bool conditional() const;
+  std::size_t capacity() const;  // Symbols allocated
+
+  std::string str() const;
+  std::size_t hash() const;
+
+  bool operator==(const Condition &rhs) const;
+  bool operator!=(const Condition &rhs) const;
+  bool operator<(const Condition &rhs) const;
+
+ private:
+  // Instance variables
+  std::vector<Symbol> symbols_;  // Target followed by the context
+  bool conditional_ = false;
+};
+
+}  // namespace config
+
+namespace std {
+
+/**
+ * @struct hash<config::Condition>
+ * @brief Specialization to use config::Condition in hashed containers
+ */
+template<>
+struct hash<config::Condition> {
+  std::size_t operator()(const config::Condition &condition) const {
+    return condition.hash();
+  }
+};
+
+}  // namespace std
+
+#endif  // CONFIG_CONDITION_
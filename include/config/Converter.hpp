@@ -22,6 +22,7 @@
 
 // Standard headers
 #include <memory>
+#include <string>
 
 // Internal headers
 #include "config/Options.hpp"
@@ -42,12 +43,15 @@ using ConverterPtr = std::shared_ptr<Converter>;
 /**
  * @class Converter
  * @brief Class to convert outter to/from inner symbols
+ *
+ * Outter symbols are read from and written to datasets as plain strings,
+ * so that converting them never interns them.
  */
 class Converter {
  public:
   // Purely virtual methods
-  virtual model::Symbol convert(const option::Symbol &orig) const = 0;
-  virtual option::Symbol convert(const model::Symbol &orig) const = 0;
+  virtual model::Symbol convert(const std::string &orig) const = 0;
+  virtual std::string convert(const model::Symbol &orig) const = 0;
 };
 
 }  // namespace config
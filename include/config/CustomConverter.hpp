@@ -22,7 +22,12 @@
 
 // Standard headers
 #include <memory>
+#include <string>
+#include <vector>
+#include <cstddef>
 #include <functional>
+#include <shared_mutex>
+#include <unordered_map>
 
 // Internal headers
 #include "config/Options.hpp"
@@ -44,25 +49,45 @@ using CustomConverterPtr = std::shared_ptr<CustomConverter>;
 /**
  * @class CustomConverter
  * @brief Class to convert outter to inner alphabet with user-provided functions
+ *
+ * Functions are assumed to always give the same result for the same
+ * symbol. Results are remembered for the symbols of a declared alphabet
+ * and for the first distinct symbols converted, up to a maximum, so that
+ * the functions (usually written in ChaiScript) are called once for each.
  */
 class CustomConverter : public Converter {
  public:
   // Aliases
-  using OutToInFunction = std::function<model::Symbol(const option::Symbol&)>;
-  using InToOutFunction = std::function<option::Symbol(const model::Symbol&)>;
+  using OutToInFunction = option::OutToInSymbolFunction;
+  using InToOutFunction = option::InToOutSymbolFunction;
+
+  // Static variables
+  static const std::size_t default_max_cached = 1 << 16;
 
   // Constructors
-  explicit CustomConverter(OutToInFunction out_to_in,
-                           InToOutFunction in_to_out);
+  CustomConverter(OutToInFunction out_to_in,
+                  InToOutFunction in_to_out,
+                  std::size_t max_cached = default_max_cached);
+
+  CustomConverter(OutToInFunction out_to_in,
+                  InToOutFunction in_to_out,
+                  const option::Alphabet &alphabet,
+                  std::size_t max_cached = default_max_cached);
 
   // Overriden methods
-  model::Symbol convert(const option::Symbol &orig) const override;
-  option::Symbol convert(const model::Symbol &orig) const override;
+  model::Symbol convert(const std::string &orig) const override;
+  std::string convert(const model::Symbol &orig) const override;
 
  private:
   // Instance variables
   OutToInFunction out_to_in_;
   InToOutFunction in_to_out_;
+  std::size_t max_cached_;
+
+  mutable std::shared_timed_mutex mutex_;
+  mutable std::unordered_map<std::string, model::Symbol> out_to_in_cache_;
+  mutable std::vector<std::string> in_to_out_cache_;  // By inner symbol
+  mutable std::vector<bool> in_to_out_cached_;
 };
 
 }  // namespace config
@@ -21,8 +21,10 @@
 #define CONFIG_DISCRETE_CONVERTER_
 
 // Standard headers
-#include <map>
 #include <memory>
+#include <string>
+#include <vector>
+#include <unordered_map>
 
 // Internal headers
 #include "config/Options.hpp"
@@ -51,13 +53,13 @@ class DiscreteConverter : public Converter {
   explicit DiscreteConverter(const option::Alphabet &alphabet);
 
   // Overriden methods
-  model::Symbol convert(const option::Symbol &orig) const override;
-  option::Symbol convert(const model::Symbol &orig) const override;
+  model::Symbol convert(const std::string &orig) const override;
+  std::string convert(const model::Symbol &orig) const override;
 
  private:
   // Instance variables
-  std::map<model::Symbol, option::Symbol> in_to_out_;
-  std::map<option::Symbol, model::Symbol> out_to_in_;
+  std::vector<option::Symbol> in_to_out_;  // Inner symbols are positions
+  std::unordered_map<std::string, model::Symbol> out_to_in_;
 };
 
 }  // namespace config
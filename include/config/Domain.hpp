@@ -22,6 +22,7 @@
 
 // Standard headers
 #include <memory>
+#include <cstddef>
 #include <iostream>
 
 // Internal headers
@@ -44,12 +45,17 @@ using DomainPtr = std::shared_ptr<Domain>;
 /**
  * @class Domain
  * @brief Class representing a domain of an input sequence
+ *
+ * Discrete domains with the same alphabet share a single converter and
+ * data, which must not be modified. Equal discrete domains can then be
+ * told apart from different ones by comparing these pointers.
  */
 class Domain {
  public:
   // Tags
   class discrete_domain {};
   class custom_domain {};
+  class range_domain {};
 
   // Alias
   using Data = config_with_options<>::type;
@@ -63,10 +69,26 @@ class Domain {
   Domain(custom_domain, option::OutToInSymbolFunction out_to_in,
                         option::InToOutSymbolFunction in_to_out);
 
+  // Decimal integers from min to max, both inclusive
+  Domain(range_domain, option::Size min, option::Size max);
+
+  // Conversions of the given symbols are computed in advance
+  Domain(custom_domain, option::OutToInSymbolFunction out_to_in,
+                        option::InToOutSymbolFunction in_to_out,
+                        const option::Alphabet &alphabet);
+
+  // Conversions are remembered for up to max_cached distinct symbols
+  Domain(custom_domain, option::OutToInSymbolFunction out_to_in,
+                        option::InToOutSymbolFunction in_to_out,
+                        std::size_t max_cached);
+
   // Concrete methods
   ConverterPtr makeConverter() const;
   std::shared_ptr<Data> data();
 
+  bool operator==(const Domain &rhs) const;
+  bool operator!=(const Domain &rhs) const;
+
   // Destructor
   virtual ~Domain() = default;
 
@@ -81,9 +103,18 @@ class Domain {
     option::InToOutSymbolFunction(decltype("in_to_out"_t))
   >::extending<Data>::type;
 
+  using RangeDomainData = config_with_options<
+    option::Size(decltype("min"_t)),
+    option::Size(decltype("max"_t))
+  >::extending<Data>::type;
+
   // Instance variables
   ConverterPtr converter_;
   DataPtr data_;
+
+  // Concrete methods
+  void setCustomData(option::OutToInSymbolFunction out_to_in,
+                     option::InToOutSymbolFunction in_to_out);
 };
 
 }  // namespace config
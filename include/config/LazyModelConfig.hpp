@@ -0,0 +1,85 @@
+/***********************************************************************/
+/*  Copyright 2016 ToPS                                                */
+/*                                                                     */
+/*  This program is free software; you can redistribute it and/or      */
+/*  modify it under the terms of the GNU  General Public License as    */
+/*  published by the Free Software Foundation; either version 3 of     */
+/*  the License, or (at your option) any later version.                */
+/*                                                                     */
+/*  This program is distributed in the hope that it will be useful,    */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of     */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the      */
+/*  GNU General Public License for more details.                       */
+/*                                                                     */
+/*  You should have received a copy of the GNU General Public License  */
+/*  along with this program; if not, write to the Free Software        */
+/*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,         */
+/*  MA 02110-1301, USA.                                                */
+/***********************************************************************/
+
+#ifndef CONFIG_LAZY_MODEL_CONFIG_
+#define CONFIG_LAZY_MODEL_CONFIG_
+
+// Standard headers
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <cstddef>
+#include <functional>
+
+// Internal headers
+#include "config/BasicConfig.hpp"
+#include "config/ModelConfig.hpp"
+
+namespace config {
+
+/**
+ * @class LazyModelConfig
+ * @brief Proxy to a config::ModelConfig only loaded when first needed
+ *
+ * Visitors see the loaded model. The options of the proxy itself are never
+ * written, so that threads may share it before it is loaded: code that
+ * reads any option, including the model type and observations, must call
+ * resolve() on the pointer first.
+ */
+class LazyModelConfig : public ModelConfig {
+ public:
+  // Alias
+  using Loader = std::function<ModelConfigPtr()>;
+
+  // Constructors
+  LazyModelConfig(const std::string &path, Loader loader);
+
+  // Static methods
+  static std::shared_ptr<LazyModelConfig> make(const std::string &path,
+                                               Loader loader);
+  static ModelConfigPtr resolve(ModelConfigPtr model_ptr);
+
+  // Overriden methods
+  void accept(ModelConfigVisitor &visitor) const override;
+  void accept(ModelConfigVisitor &&visitor) const override;
+
+  std::size_t number_of_options() const override;
+
+  // Concrete methods
+  ModelConfigPtr model() const;
+  bool loaded() const;
+
+ private:
+  // Instance variables
+  Loader loader_;
+  mutable ModelConfigPtr model_;
+  mutable std::once_flag once_;
+  mutable std::atomic<bool> loaded_;
+};
+
+/**
+ * @typedef LazyModelConfigPtr
+ * @brief Alias of pointer to LazyModelConfig
+ */
+using LazyModelConfigPtr = std::shared_ptr<LazyModelConfig>;
+
+}  // namespace config
+
+#endif  // CONFIG_LAZY_MODEL_CONFIG_
@@ -19,6 +19,7 @@
 
 // Standard headers
 #include <memory>
+#include <string>
 
 namespace config {
 
@@ -39,7 +40,9 @@ inline void ModelConfigVisitor::visit(
   config_ptr->for_each([this, &count, &max] (const auto &tag, auto &value) {
     using Tag = std::remove_cv_t<std::remove_reference_t<decltype(tag)>>;
     using Value = std::remove_cv_t<std::remove_reference_t<decltype(value)>>;
-    this->visitTag(typename Tag::value_type().str(), count, max);
+    // Names of tags are built once for each type of option
+    static const std::string name = typename Tag::value_type().str();
+    this->visitTag(name, count, max);
     this->visitOption(const_cast<Value&>(value));
     count++;
   });
@@ -27,13 +27,16 @@
 #include <functional>
 
 // Internal headers
+#include "config/SymbolTable.hpp"
+#include "config/ProbabilityTable.hpp"
+
 #include "model/Symbol.hpp"
 
 namespace config {
 namespace option {
 
 using Type = std::string;
-using Symbol = std::string;
+using Symbol = SymbolTable::Symbol;
 using Pattern = std::string;
 using Sequence = std::string;
 
@@ -43,16 +46,17 @@ using Alphabet = std::vector<Symbol>;
 using Alphabets = std::vector<Alphabet>;
 
 using Probability = double;
-using Probabilities = std::map<std::string, Probability>;
+using Probabilities = ProbabilityTable;
 
 using FeatureFunction = std::function<
   double(unsigned int, unsigned int, std::vector<unsigned int>, unsigned int)>;
 using FeatureFunctions = std::map<std::string, FeatureFunction>;
 
+// Symbols of datasets are converted as plain strings, without interning
 using OutToInSymbolFunction
-  = std::function<model::Symbol(const option::Symbol&)>;
+  = std::function<model::Symbol(const std::string&)>;
 using InToOutSymbolFunction
-  = std::function<option::Symbol(const model::Symbol&)>;
+  = std::function<std::string(const model::Symbol&)>;
 
 }  // namespace option
 }  // namespace config
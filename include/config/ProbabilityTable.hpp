@@ -0,0 +1,110 @@
+/***********************************************************************/
+/*  Copyright 2016 ToPS                                                */
+/*                                                                     */
+/*  This program is free software; you can redistribute it and/or      */
+/*  modify it under the terms of the GNU  General Public License as    */
+/*  published by the Free Software Foundation; either version 3 of     */
+/*  the License, or (at your option) any later version.                */
+/*                                                                     */
+/*  This program is distributed in the hope that it will be useful,    */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of     */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the      */
+/*  GNU General Public License for more details.                       */
+/*                                                                     */
+/*  You should have received a copy of the GNU General Public License  */
+/*  along with this program; if not, write to the Free Software        */
+/*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,         */
+/*  MA 02110-1301, USA.                                                */
+/***********************************************************************/
+
+#ifndef CONFIG_PROBABILITY_TABLE_
+#define CONFIG_PROBABILITY_TABLE_
+
+// Standard headers
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <initializer_list>
+
+// Internal headers
+#include "config/Condition.hpp"
+
+namespace config {
+
+/**
+ * @class ProbabilityTable
+ * @brief Hashed flat map from config::Condition to probabilities
+ *
+ * Entries are stored contiguously in insertion order, and looked up
+ * through an open-addressing index of 32-bit positions. Entries are never
+ * erased. Keys may also be given in the text syntax `"target | context"`.
+ * As in std::set, iterators are read-only, so that keys never change behind
+ * the index; probabilities are written through operator[] and at().
+ */
+class ProbabilityTable {
+ public:
+  // Alias
+  using key_type = Condition;
+  using mapped_type = double;
+  using value_type = std::pair<Condition, double>;
+
+  using iterator = std::vector<value_type>::const_iterator;
+  using const_iterator = std::vector<value_type>::const_iterator;
+
+  // Constructors
+  ProbabilityTable() = default;
+  ProbabilityTable(std::initializer_list<value_type> entries);
+
+  // Concrete methods
+  double &operator[](const Condition &key);
+  double &operator[](Condition &&key);
+  double &operator[](const std::string &key);
+
+  double &at(const Condition &key);
+  const double &at(const Condition &key) const;
+
+  const_iterator find(const Condition &key) const;
+  std::size_t count(const Condition &key) const;
+
+  std::pair<iterator, bool> emplace(const Condition &key, double value);
+  std::pair<iterator, bool> emplace(Condition &&key, double value);
+
+  template<typename InputIterator>
+  void insert(InputIterator first, InputIterator last);
+
+  void reserve(std::size_t size);
+  void clear();
+
+  std::size_t size() const;
+  bool empty() const;
+
+  std::size_t capacity() const;      // Entries allocated
+  std::size_t bucket_count() const;  // Slots of the index
+
+  const_iterator begin() const;
+  const_iterator end() const;
+
+  bool operator==(const ProbabilityTable &rhs) const;
+  bool operator!=(const ProbabilityTable &rhs) const;
+
+ private:
+  // Instance variables
+  std::vector<value_type> entries_;
+  std::vector<std::uint32_t> slots_;  // Position of entry + 1, or 0 if empty
+
+  // Concrete methods
+  template<typename Key>
+  std::pair<std::size_t, bool> emplaceKey(Key &&key, double value);
+
+  std::size_t findSlot(const Condition &key) const;
+  void rehash(std::size_t number_of_slots);
+};
+
+}  // namespace config
+
+// Implementation header
+#include "config/ProbabilityTable.ipp"
+
+#endif  // CONFIG_PROBABILITY_TABLE_
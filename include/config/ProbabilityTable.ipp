@@ -0,0 +1,43 @@
+/***********************************************************************/
+/*  Copyright 2016 ToPS                                                */
+/*                                                                     */
+/*  This program is free software; you can redistribute it and/or      */
+/*  modify it under the terms of the GNU  General Public License as    */
+/*  published by the Free Software Foundation; either version 3 of     */
+/*  the License, or (at your option) any later version.                */
+/*                                                                     */
+/*  This program is distributed in the hope that it will be useful,    */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of     */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the      */
+/*  GNU General Public License for more details.                       */
+/*                                                                     */
+/*  You should have received a copy of the GNU General Public License  */
+/*  along with this program; if not, write to the Free Software        */
+/*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,         */
+/*  MA 02110-1301, USA.                                                */
+/***********************************************************************/
+
+// Standard headers
+#include <iterator>
+#include <type_traits>
+
+namespace config {
+
+/*----------------------------------------------------------------------------*/
+/*                              CONCRETE METHODS                              */
+/*----------------------------------------------------------------------------*/
+
+template<typename InputIterator>
+void ProbabilityTable::insert(InputIterator first, InputIterator last) {
+  using category
+    = typename std::iterator_traits<InputIterator>::iterator_category;
+  if (std::is_base_of<std::forward_iterator_tag, category>::value)
+    reserve(size() + static_cast<std::size_t>(std::distance(first, last)));
+
+  for (; first != last; ++first)
+    emplace(first->first, first->second);
+}
+
+/*----------------------------------------------------------------------------*/
+
+}  // namespace config
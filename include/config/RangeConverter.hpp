@@ -0,0 +1,69 @@
+/***********************************************************************/
+/*  Copyright 2016 ToPS                                                */
+/*                                                                     */
+/*  This program is free software; you can redistribute it and/or      */
+/*  modify it under the terms of the GNU  General Public License as    */
+/*  published by the Free Software Foundation; either version 3 of     */
+/*  the License, or (at your option) any later version.                */
+/*                                                                     */
+/*  This program is distributed in the hope that it will be useful,    */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of     */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the      */
+/*  GNU General Public License for more details.                       */
+/*                                                                     */
+/*  You should have received a copy of the GNU General Public License  */
+/*  along with this program; if not, write to the Free Software        */
+/*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,         */
+/*  MA 02110-1301, USA.                                                */
+/***********************************************************************/
+
+#ifndef CONFIG_RANGE_CONVERTER_
+#define CONFIG_RANGE_CONVERTER_
+
+// Standard headers
+#include <memory>
+#include <string>
+
+// Internal headers
+#include "config/Options.hpp"
+#include "config/Converter.hpp"
+
+#include "model/Symbol.hpp"
+
+namespace config {
+
+// Forward declarations
+class RangeConverter;
+
+/**
+ * @typedef RangeConverterPtr
+ * @brief Alias of pointer to RangeConverter
+ */
+using RangeConverterPtr = std::shared_ptr<RangeConverter>;
+
+/**
+ * @class RangeConverter
+ * @brief Class to convert decimal integers in [min, max] to inner alphabet
+ *
+ * The integer `min + i` is converted to the inner symbol `i`. Symbols not
+ * written as plain decimal integers or out of bounds throw
+ * std::out_of_range, as unknown symbols of discrete domains do.
+ */
+class RangeConverter : public Converter {
+ public:
+  // Constructors
+  RangeConverter(option::Size min, option::Size max);
+
+  // Overriden methods
+  model::Symbol convert(const std::string &orig) const override;
+  std::string convert(const model::Symbol &orig) const override;
+
+ private:
+  // Instance variables
+  option::Size min_;
+  option::Size max_;
+};
+
+}  // namespace config
+
+#endif  // CONFIG_RANGE_CONVERTER_
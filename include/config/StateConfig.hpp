@@ -57,7 +57,7 @@ namespace config {
 namespace option {
 
 using State = StateConfigPtr;
-using States = std::map<std::string, State>;
+using States = std::map<Symbol, State>;
 
 }  // namespace option
 }  // namespace config
@@ -0,0 +1,178 @@
+/***********************************************************************/
+/*  Copyright 2016 ToPS                                                */
+/*                                                                     */
+/*  This program is free software; you can redistribute it and/or      */
+/*  modify it under the terms of the GNU  General Public License as    */
+/*  published by the Free Software Foundation; either version 3 of     */
+/*  the License, or (at your option) any later version.                */
+/*                                                                     */
+/*  This program is distributed in the hope that it will be useful,    */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of     */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the      */
+/*  GNU General Public License for more details.                       */
+/*                                                                     */
+/*  You should have received a copy of the GNU General Public License  */
+/*  along with this program; if not, write to the Free Software        */
+/*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,         */
+/*  MA 02110-1301, USA.                                                */
+/***********************************************************************/
+
+#ifndef CONFIG_SYMBOL_TABLE_
+#define CONFIG_SYMBOL_TABLE_
+
+// Standard headers
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <cstddef>
+#include <ostream>
+#include <functional>
+#include <unordered_set>
+
+namespace config {
+
+// Forward declarations
+class SymbolTable;
+
+/**
+ * @typedef SymbolTablePtr
+ * @brief Alias of pointer to SymbolTable
+ */
+using SymbolTablePtr = std::shared_ptr<SymbolTable>;
+
+/**
+ * @class SymbolTable
+ * @brief Table of interned strings, such as symbols, labels and paths
+ *
+ * Each distinct string is stored once, and handed out as a pointer-sized
+ * Symbol that reads it without locking. Symbols of the same table are
+ * compared by address, and symbols of different tables by their strings.
+ * Strings are interned in the current table: the one of the innermost
+ * Scope opened by this thread (see lang::Interpreter), or a table shared
+ * by the whole process when there is none. A symbol is only valid while
+ * its table is alive, so nodes of the config IR keep alive the table that
+ * was current when they were made.
+ */
+class SymbolTable {
+ private:
+  // Inner structs
+  struct Entry {
+    std::string name;
+    std::size_t hash;
+  };
+
+ public:
+  // Inner classes
+  class Symbol {
+   public:
+    // Constructors
+    Symbol();  // Empty string, not interned
+    Symbol(const std::string &name);  // NOLINT(runtime/explicit)
+    Symbol(const char *name);  // NOLINT(runtime/explicit)
+
+    // Concrete methods
+    const std::string &str() const;
+    std::size_t hash() const;
+
+    operator const std::string &() const;  // NOLINT(runtime/explicit)
+
+    bool operator==(const Symbol &rhs) const;
+    bool operator!=(const Symbol &rhs) const;
+    bool operator<(const Symbol &rhs) const;
+
+    // Compared without interning the string
+    bool operator==(const std::string &rhs) const;
+    bool operator!=(const std::string &rhs) const;
+    bool operator==(const char *rhs) const;
+    bool operator!=(const char *rhs) const;
+
+   private:
+    // Friend classes
+    friend class SymbolTable;
+
+    // Constructors
+    explicit Symbol(const Entry *entry);
+
+    // Instance variables
+    const Entry *entry_;
+  };
+
+  class Scope {
+   public:
+    // Constructors
+    explicit Scope(SymbolTablePtr table);  // Makes table current
+
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+
+    // Destructor
+    ~Scope();
+
+   private:
+    // Instance variables
+    SymbolTablePtr previous_;
+  };
+
+  // Constructors
+  SymbolTable() = default;
+
+  SymbolTable(const SymbolTable &) = delete;
+  SymbolTable &operator=(const SymbolTable &) = delete;
+
+  // Static methods
+  static const SymbolTablePtr &current();
+
+  // Concrete methods
+  Symbol intern(const char *name, std::size_t size);
+  Symbol intern(const std::string &name);
+
+  std::size_t size() const;  // Strings interned
+
+ private:
+  // Inner structs
+  struct EntryHash {
+    std::size_t operator()(const Entry &entry) const { return entry.hash; }
+  };
+
+  struct EntryEqual {
+    bool operator()(const Entry &lhs, const Entry &rhs) const {
+      return lhs.name == rhs.name;
+    }
+  };
+
+  // Instance variables
+  mutable std::mutex mutex_;
+  std::unordered_set<Entry, EntryHash, EntryEqual> entries_;  // Never move
+
+  // Entry of each one-character name, read without locking
+  std::atomic<const Entry *> characters_[256] {};
+
+  // Static methods
+  static const Entry *emptyEntry();
+};
+
+// Operators
+bool operator==(const std::string &lhs, const SymbolTable::Symbol &rhs);
+bool operator!=(const std::string &lhs, const SymbolTable::Symbol &rhs);
+
+std::ostream &operator<<(std::ostream &os, const SymbolTable::Symbol &symbol);
+
+}  // namespace config
+
+namespace std {
+
+/**
+ * @struct hash<config::SymbolTable::Symbol>
+ * @brief Specialization to use symbols in hashed containers
+ */
+template<>
+struct hash<config::SymbolTable::Symbol> {
+  std::size_t operator()(const config::SymbolTable::Symbol &symbol) const {
+    return symbol.hash();
+  }
+};
+
+}  // namespace std
+
+#endif  // CONFIG_SYMBOL_TABLE_
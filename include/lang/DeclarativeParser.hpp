@@ -0,0 +1,134 @@
+/***********************************************************************/
+/*  Copyright 2016 ToPS                                                */
+/*                                                                     */
+/*  This program is free software; you can redistribute it and/or      */
+/*  modify it under the terms of the GNU  General Public License as    */
+/*  published by the Free Software Foundation; either version 3 of     */
+/*  the License, or (at your option) any later version.                */
+/*                                                                     */
+/*  This program is distributed in the hope that it will be useful,    */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of     */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the      */
+/*  GNU General Public License for more details.                       */
+/*                                                                     */
+/*  You should have received a copy of the GNU General Public License  */
+/*  along with this program; if not, write to the Free Software        */
+/*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,         */
+/*  MA 02110-1301, USA.                                                */
+/***********************************************************************/
+
+#ifndef LANG_DECLARATIVE_PARSER_
+#define LANG_DECLARATIVE_PARSER_
+
+// Standard headers
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <unordered_map>
+
+namespace lang {
+
+/**
+ * @class DeclarativeParser
+ * @brief Recursive-descent parser for data-only configuration files
+ *
+ * Recognizes files made only of assignments of literals: strings,
+ * numbers, vectors, maps, `|` / `->` conditions, arithmetic and calls to the
+ * helpers `model`, `explicit`, `geometric`, `fixed`, `max_length`, `lib`,
+ * `tree`, `table`, `discrete_domain` and `range_domain`. Strings point
+ * directly to the contents of the file. Any other construct makes the file
+ * non-declarative, so it must be evaluated by ChaiScript.
+ */
+class DeclarativeParser {
+ public:
+  // Inner structs
+  struct Value {
+    enum class Kind { String, Integer, Real, List, Map, Call, Condition };
+
+    Kind kind;
+    const char *data = nullptr;  // String contents or name of Call
+    std::size_t size = 0;
+
+    long long integer = 0;
+    double real = 0;
+
+    std::vector<Value> keys;    // Keys of Map
+    std::vector<Value> values;  // Elements of List / Map, arguments of Call,
+                                // target and context of Condition
+
+    std::string string() const;
+    double number() const;
+
+    bool isString() const;
+    bool isNumber() const;
+    bool isCondition() const;
+    bool isCall(const std::string &name) const;
+  };
+
+  using Statements = std::unordered_map<std::string, Value>;
+
+  // Constructors
+  explicit DeclarativeParser(std::string filepath);
+
+  // Concrete methods
+  bool parse();
+
+  const std::string &filepath() const;
+  const Statements &statements() const;
+  const Value *find(const std::string &name) const;
+
+  std::string modelType() const;
+
+ private:
+  // Inner structs
+  struct unsupported_feature {};
+
+  // Instance variables
+  std::string filepath_;
+  std::string buffer_;
+  std::deque<std::string> strings_;
+
+  const char *it_;
+  const char *end_;
+
+  Statements statements_;
+
+  // Concrete methods
+  void parseStatement();
+
+  Value parseExpression();
+  Value parseSum();
+  Value parseProduct();
+  Value parseUnary();
+  Value parsePrimary();
+
+  Value parseString();
+  Value parseNumber();
+  Value parseContainer();
+  Value parseCall(const char *name, std::size_t size);
+  std::size_t parseIdentifier();
+
+  Value concatenate(const Value &lhs, const Value &rhs,
+                    const char *separator);
+  Value condition(const Value &target, const Value &context);
+  Value calculate(char operation, const Value &lhs, const Value &rhs);
+
+  void skipBlanks();
+  void consume(char c);
+  char next(std::size_t n = 1) const;
+
+  [[noreturn]] void unsupported() const;
+  [[noreturn]] void error(const std::string &reason) const;
+};
+
+/**
+ * @typedef DeclarativeParserPtr
+ * @brief Alias of pointer to DeclarativeParser
+ */
+using DeclarativeParserPtr = std::shared_ptr<DeclarativeParser>;
+
+}  // namespace lang
+
+#endif  // LANG_DECLARATIVE_PARSER_
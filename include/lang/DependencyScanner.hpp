@@ -0,0 +1,76 @@
+/***********************************************************************/
+/*  Copyright 2016 ToPS                                                */
+/*                                                                     */
+/*  This program is free software; you can redistribute it and/or      */
+/*  modify it under the terms of the GNU  General Public License as    */
+/*  published by the Free Software Foundation; either version 3 of     */
+/*  the License, or (at your option) any later version.                */
+/*                                                                     */
+/*  This program is distributed in the hope that it will be useful,    */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of     */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the      */
+/*  GNU General Public License for more details.                       */
+/*                                                                     */
+/*  You should have received a copy of the GNU General Public License  */
+/*  along with this program; if not, write to the Free Software        */
+/*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,         */
+/*  MA 02110-1301, USA.                                                */
+/***********************************************************************/
+
+#ifndef LANG_DEPENDENCY_SCANNER_
+#define LANG_DEPENDENCY_SCANNER_
+
+// Standard headers
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace lang {
+
+/**
+ * @class DependencyScanner
+ * @brief Lexer that finds the files referenced by a configuration file
+ *
+ * Only the calls `model("...")`, `explicit("...")`, `lib("...")`,
+ * `tree("...")`, `table("...")` and `use("...")` are recognized, without
+ * evaluating the file. The same calls are found in the nodes of `.tree`
+ * files. Calls whose path is not a single string literal, such as
+ * `model(dir + "x.tops")`, are reported as dynamic references, whose file
+ * is only known after evaluation.
+ * scanGraph() follows them recursively to build the whole dependency DAG.
+ */
+class DependencyScanner {
+ public:
+  // Inner structs
+  struct Dependency {
+    std::string helper;
+    std::string filepath;
+    std::string root_dir;  // Directory where its references are resolved
+    bool dynamic = false;  // Path computed at runtime, filepath is empty
+  };
+
+  struct Graph {
+    std::vector<std::string> files;  // Dependencies come before dependents
+    std::map<std::string, std::set<std::string>> dependencies;
+    std::set<std::string> dynamic;  // Files with dynamic references
+  };
+
+  // Concrete methods
+  std::vector<Dependency> scan(const std::string &filepath);
+  std::vector<Dependency> scan(const std::string &filepath,
+                               const std::string &root_dir);
+
+  Graph scanGraph(const std::string &filepath);
+
+ private:
+  // Concrete methods
+  void scanGraph(const std::string &filepath,
+                 const std::string &root_dir,
+                 std::set<std::string> &visited,
+                 Graph &graph);
+};
+
+}  // namespace lang
+
+#endif  // LANG_DEPENDENCY_SCANNER_
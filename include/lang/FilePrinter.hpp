@@ -30,8 +30,11 @@
 
 // Internal headers
 #include "lang/Util.hpp"
+#include "lang/OutputBuffer.hpp"
 
 #include "config/Domain.hpp"
+#include "config/Options.hpp"
+#include "config/Condition.hpp"
 #include "config/BasicConfig.hpp"
 
 #include "config/ModelConfig.hpp"
@@ -69,11 +72,14 @@ class FilePrinter {
   // Virtual methods
   virtual void changeOstream(const std::string &/* path */);
 
+  virtual void print(const config::option::Probabilities &probabilities);
+
   virtual void startPrinting();
   virtual void endPrinting();
 
   // Concrete methods
   void print(const std::string &string);
+  void print(const config::Condition &condition);
   void print(float num);
   void print(double num);
   void print(unsigned int num);
@@ -98,12 +104,13 @@ class FilePrinter {
 
  protected:
   // Instance variables
-  std::shared_ptr<std::ostream> os_;
+  OutputBufferPtr os_;
   unsigned int depth_;
+  std::string tag_;
 
   // Constructors
   template<typename... OptionArgs>
-  FilePrinter(std::shared_ptr<std::ostream> os,
+  FilePrinter(OutputBufferPtr os,
               unsigned int initial_depth,
               OptionArgs&&... option_args);
 
@@ -119,8 +126,9 @@ class FilePrinter {
   void indent(unsigned int extra_depth = 0);
 
   template<typename Base, typename... Options>
-  void copy(std::shared_ptr<config::BasicConfig<Base, Options...>> config_ptr,
-            std::shared_ptr<std::ostream> os);
+  static void copy(
+      std::shared_ptr<config::BasicConfig<Base, Options...>> config_ptr,
+      OutputBuffer &os, unsigned int depth);
 
  private:
   // Instance variables
@@ -31,7 +31,7 @@ namespace lang {
 /*----------------------------------------------------------------------------*/
 
 template<typename... OptionArgs>
-FilePrinter::FilePrinter(std::shared_ptr<std::ostream> os,
+FilePrinter::FilePrinter(OutputBufferPtr os,
                          unsigned int initial_depth,
                          OptionArgs&&... option_args)
     : os_(os), depth_(initial_depth),
@@ -76,12 +76,12 @@ auto FilePrinter::print(const Iterable &iterable)
 template<typename Base, typename... Options>
 void FilePrinter::copy(
     std::shared_ptr<config::BasicConfig<Base, Options...>> config_ptr,
-    std::shared_ptr<std::ostream> os) {
+    OutputBuffer &os, unsigned int depth) {
   std::ifstream src(config_ptr->path());
   std::string line;
   while (std::getline(src, line)) {
-    indent();
-    *os << line << std::endl;
+    os.appendSpaces(2 * depth);
+    os << line << '\n';
   }
 }
 
@@ -21,16 +21,25 @@
 #define LANG_INTERPRETER_
 
 // Standard headers
+#include <mutex>
 #include <string>
 #include <memory>
 #include <exception>
 #include <unordered_map>
 
 // Internal headers
+#include "lang/Tracer.hpp"
+#include "lang/ModelConfigCache.hpp"
+#include "lang/DeclarativeParser.hpp"
+
 #include "config/Converter.hpp"
 #include "config/ModelConfig.hpp"
+#include "config/SymbolTable.hpp"
+#include "config/DependencyTreeConfig.hpp"
+#include "config/FeatureFunctionLibraryConfig.hpp"
 
 // External headers
+#include "chaiscript/chaiscript.hpp"
 #include "chaiscript/dispatchkit/dispatchkit.hpp"
 
 namespace lang {
@@ -38,43 +47,107 @@ namespace lang {
 /**
  * @class Interpreter
  * @brief Interpreter for ToPS' configuration file language
+ *
+ * Models may be evaluated from many threads at once. Bindings that do not
+ * depend on the file being evaluated are built once per interpreter and
+ * shared by its copies; helpers resolving paths are built for each file.
+ * Symbols, labels and paths of evaluated models are interned in a
+ * config::SymbolTable owned by the interpreter and shared by its copies.
  */
 class Interpreter {
  public:
+  // Constructors
+  Interpreter();
+  explicit Interpreter(const std::string &cache_dir);
+
   // Concrete methods
   config::ModelConfigPtr evalModel(const std::string &filepath);
 
+  // Submodels are only evaluated when first visited or resolved
+  void setLazy(bool lazy);
+
+  // Files already evaluated are reused by later calls to evalModel
+  void setMemoize(bool memoize);
+
+  // Evaluation phases are recorded while a tracer is set
+  void setTracer(TracerPtr tracer);
+
+  // Config nodes of each model are allocated together, and freed all at
+  // once. Strings, vectors and tables inside them stay on the heap. An
+  // arena lives as long as any of its nodes, so when memoizing, each file
+  // gets an arena of its own: a memoized submodel would otherwise keep
+  // alive the arena of the model that first referenced it.
+  void setArena(bool arena);
+
  private:
+  // Friend classes
+  friend class ModelConfigFiller;
+  friend class ModelWatcher;
+  friend class DependencyTreeParser;
+
   // Enums
   enum class ModelType {
     GHMM, HMM, LCCRF, IID, VLMC, IMC, PeriodicIMC, SBSW, MSM, MDD
   };
 
+  // Inner structs
+  struct ModelMemo {
+    std::mutex mutex;
+    std::unordered_map<std::string, config::ModelConfigPtr> models;
+  };
+
   // Static variables
   static const std::unordered_map<std::string, ModelType> model_type_map;
 
+  // Instance variables
+  chaiscript::ModulePtr library_;
+  std::shared_ptr<ModelConfigCache> cache_;
+  TracerPtr tracer_;
+  bool lazy_ = false;
+  bool arena_ = false;
+
+  // Evaluated models by path, reused while present (see ModelWatcher)
+  std::shared_ptr<ModelMemo> models_;
+
+  // Kept alive by the models interned in it after the interpreter is gone;
+  // accessed atomically, as ModelWatcher replaces it on every reload
+  config::SymbolTablePtr symbols_ = std::make_shared<config::SymbolTable>();
+
   // Concrete methods
   void checkExtension(const std::string &filepath);
   config::ModelConfigPtr makeModelConfig(const std::string &filepath);
+  config::ModelConfigPtr interpretModelConfig(const std::string &filepath);
+  config::ModelConfigPtr makeSubmodelConfig(const std::string &filepath);
+  config::FeatureFunctionLibraryConfigPtr makeLibraryConfig(
+      const std::string &filepath);
 
-  ModelType findModelType(const std::string &filepath);
+  ModelType findModelType(const std::string &filepath,
+                          DeclarativeParserPtr parser);
   bool missingObjectException(const std::exception &e);
 
   template<typename Config>
-  std::shared_ptr<Config> fillConfig(const std::string &filepath);
+  std::shared_ptr<Config> fillConfig(const std::string &filepath,
+                                     DeclarativeParserPtr parser = nullptr);
 
-  chaiscript::ModulePtr makeInterpreterLibrary(const std::string &filepath);
+  config::DependencyTreeConfigPtr makeDependencyTree(
+      const std::string &root_dir, const std::string &file);
+
+  void addLibraries(chaiscript::ChaiScript &chai,
+                    const std::string &filepath);
+  chaiscript::ModulePtr makeFileLibrary(const std::string &filepath);
 
-  void registerTypes(chaiscript::ModulePtr &module,
-                     const std::string &filepath);
   void registerHelpers(chaiscript::ModulePtr &module,
                        const std::string &filepath);
-  void registerConstants(chaiscript::ModulePtr &module,
-                         const std::string &filepath);
-  void registerAttributions(chaiscript::ModulePtr &module,
-                            const std::string &filepath);
-  void registerConcatenations(chaiscript::ModulePtr &module,
-                              const std::string &filepath);
+  void registerFileAttributions(chaiscript::ModulePtr &module,
+                                const std::string &filepath);
+
+  // Static methods
+  static chaiscript::ModulePtr makeSharedLibrary();
+
+  static void registerTypes(chaiscript::ModulePtr &module);
+  static void registerConstants(chaiscript::ModulePtr &module);
+  static void registerAttributions(chaiscript::ModulePtr &module);
+  static void registerConcatenations(chaiscript::ModulePtr &module);
 };
 
 }  // namespace lang
@@ -24,8 +24,11 @@
 
 // Internal headers
 #include "lang/Util.hpp"
+#include "lang/ModelConfigFiller.hpp"
 #include "lang/ModelConfigRegister.hpp"
 
+#include "config/Arena.hpp"
+
 namespace lang {
 
 /*----------------------------------------------------------------------------*/
@@ -33,19 +36,39 @@ namespace lang {
 /*----------------------------------------------------------------------------*/
 
 template<typename Config>
-std::shared_ptr<Config> Interpreter::fillConfig(const std::string &filepath) {
+std::shared_ptr<Config> Interpreter::fillConfig(const std::string &filepath,
+                                                DeclarativeParserPtr parser) {
+  Tracer::Span span(tracer_, "fillConfig", filepath);
+
+  // Data-only files do not need to be evaluated by ChaiScript
+  if (parser) {
+    auto cfg = config::makeShared<Config>(filepath);
+    cfg->accept(ModelConfigFiller(this, *parser));
+    return cfg;
+  }
+
   auto root_dir = extractDir(filepath);
 
   std::vector<std::string> modulepaths;
   std::vector<std::string> usepaths { root_dir };
 
-  chaiscript::ChaiScript chai(modulepaths, usepaths);
-  chai.add(makeInterpreterLibrary(filepath));
+  std::unique_ptr<chaiscript::ChaiScript> chai;
+  {
+    Tracer::Span engine_span(tracer_, "engine", filepath);
+    chai = std::make_unique<chaiscript::ChaiScript>(modulepaths, usepaths);
+    addLibraries(*chai, filepath);
+  }
 
-  auto cfg = std::make_shared<Config>(filepath);
-  cfg->accept(ModelConfigRegister(chai));
+  auto cfg = config::makeShared<Config>(filepath);
+  {
+    Tracer::Span register_span(tracer_, "register", filepath);
+    cfg->accept(ModelConfigRegister(*chai));
+  }
 
-  chai.eval_file(filepath);
+  {
+    Tracer::Span eval_span(tracer_, "eval_file", filepath);
+    chai->eval_file(filepath);
+  }
 
   return cfg;
 }
@@ -0,0 +1,75 @@
+/***********************************************************************/
+/*  Copyright 2016 ToPS                                                */
+/*                                                                     */
+/*  This program is free software; you can redistribute it and/or      */
+/*  modify it under the terms of the GNU  General Public License as    */
+/*  published by the Free Software Foundation; either version 3 of     */
+/*  the License, or (at your option) any later version.                */
+/*                                                                     */
+/*  This program is distributed in the hope that it will be useful,    */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of     */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the      */
+/*  GNU General Public License for more details.                       */
+/*                                                                     */
+/*  You should have received a copy of the GNU General Public License  */
+/*  along with this program; if not, write to the Free Software        */
+/*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,         */
+/*  MA 02110-1301, USA.                                                */
+/***********************************************************************/
+
+#ifndef LANG_MODEL_CONFIG_CACHE_
+#define LANG_MODEL_CONFIG_CACHE_
+
+// Standard headers
+#include <set>
+#include <string>
+#include <cstdint>
+#include <unordered_map>
+
+// Internal headers
+#include "config/ModelConfig.hpp"
+
+namespace lang {
+
+/**
+ * @class ModelConfigCache
+ * @brief On-disk cache of evaluated models
+ *
+ * Models are stored in binary form, keyed by a hash of the contents of
+ * their file and of every file it transitively references. A cache may be
+ * shared by interpreters running in different threads or processes. Models
+ * referencing files through paths computed at runtime have no key, as a
+ * change in those files could not be detected.
+ */
+class ModelConfigCache {
+ public:
+  // Constructors
+  explicit ModelConfigCache(const std::string &cache_dir);
+
+  // Concrete methods
+  std::string key(const std::string &filepath) const;  // Empty if not cacheable
+
+  config::ModelConfigPtr load(const std::string &key);
+  void store(const std::string &key, config::ModelConfigPtr model);
+
+ private:
+  // Inner structs
+  struct Hashing {  // State of a single call to key()
+    std::set<std::string> visiting;
+    std::unordered_map<std::string, std::uint64_t> hashes;
+    bool dynamic = false;
+  };
+
+  // Instance variables
+  std::string cache_dir_;
+
+  // Concrete methods
+  std::uint64_t hash(const std::string &filepath,
+                     const std::string &root_dir,
+                     Hashing &hashing) const;
+  std::string pathForKey(const std::string &key) const;
+};
+
+}  // namespace lang
+
+#endif  // LANG_MODEL_CONFIG_CACHE_
@@ -0,0 +1,144 @@
+/***********************************************************************/
+/*  Copyright 2016 ToPS                                                */
+/*                                                                     */
+/*  This program is free software; you can redistribute it and/or      */
+/*  modify it under the terms of the GNU  General Public License as    */
+/*  published by the Free Software Foundation; either version 3 of     */
+/*  the License, or (at your option) any later version.                */
+/*                                                                     */
+/*  This program is distributed in the hope that it will be useful,    */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of     */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the      */
+/*  GNU General Public License for more details.                       */
+/*                                                                     */
+/*  You should have received a copy of the GNU General Public License  */
+/*  along with this program; if not, write to the Free Software        */
+/*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,         */
+/*  MA 02110-1301, USA.                                                */
+/***********************************************************************/
+
+#ifndef LANG_MODEL_CONFIG_PROFILER_
+#define LANG_MODEL_CONFIG_PROFILER_
+
+// Standard headers
+#include <map>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <ostream>
+#include <unordered_map>
+
+// Internal headers
+#include "config/Domain.hpp"
+#include "config/Options.hpp"
+#include "config/ModelConfigVisitor.hpp"
+
+#include "config/ModelConfig.hpp"
+#include "config/StateConfig.hpp"
+#include "config/DurationConfig.hpp"
+#include "config/DependencyTreeConfig.hpp"
+#include "config/FeatureFunctionLibraryConfig.hpp"
+
+namespace lang {
+
+/**
+ * @class ModelConfigProfiler
+ * Implementation of config::ModelConfigVisitor to estimate the memory used
+ * by a model, by file, option tag and kind of storage
+ *
+ * Objects referenced more than once are counted only the first time they
+ * are found. Lazy submodels not loaded yet are not loaded by the profiler.
+ * Captures of std::function objects stored outside of them are not
+ * visible, so functions are only counted by their own size.
+ * Paths, labels, state names and alphabet symbols are interned, so their
+ * strings are not counted by config.
+ */
+class ModelConfigProfiler : public config::ModelConfigVisitor {
+ public:
+  // Inner structs
+  struct Footprint {
+    std::size_t bytes = 0;
+    std::size_t objects = 0;
+  };
+
+  // Concrete methods
+  void profile(config::ModelConfigPtr model_ptr);
+  void report(std::ostream &os, std::size_t max_rows) const;
+
+  const Footprint &total() const;
+  const Footprint &shared() const;  // Repeated references, not in total
+
+  const std::map<std::string, Footprint> &byFile() const;
+  const std::map<std::string, Footprint> &byTag() const;
+  const std::map<std::string, Footprint> &byKind() const;
+
+ protected:
+  // Overriden functions
+  void startVisit() override;
+  void endVisit() override;
+
+  void visitOption(config::option::Model &visited) override;
+  void visitOption(config::option::State &visited) override;
+  void visitOption(config::option::Domain &visited) override;
+  void visitOption(config::option::Duration &visited) override;
+  void visitOption(config::option::DependencyTree &visited) override;
+  void visitOption(config::option::FeatureFunctionLibrary &visited) override;
+
+  void visitOption(config::option::Models &visited) override;
+  void visitOption(config::option::States &visited) override;
+  void visitOption(config::option::Domains &visited) override;
+  void visitOption(config::option::DependencyTrees &visited) override;
+  void visitOption(config::option::FeatureFunctionLibraries &visited) override;
+
+  void visitOption(config::option::Type &visited) override;
+  void visitOption(config::option::Size &visited) override;
+  void visitOption(config::option::Alphabet &visited) override;
+  void visitOption(config::option::Alphabets &visited) override;
+  void visitOption(config::option::Probability &visited) override;
+  void visitOption(config::option::Probabilities &visited) override;
+  void visitOption(config::option::FeatureFunctions &visited) override;
+
+  void visitOption(config::option::OutToInSymbolFunction &visited) override;
+  void visitOption(config::option::InToOutSymbolFunction &visited) override;
+
+  void visitTag(const std::string &tag, std::size_t /* count */,
+                                        std::size_t /* max */) override;
+
+  void visitLabel(const std::string &/* label */) override;
+  void visitPath(const std::string &path) override;
+
+ private:
+  // Inner structs
+  struct Frame {
+    std::string path;
+    std::string tag;
+  };
+
+  // Instance variables
+  std::vector<Frame> frames_;  // Configs being visited, innermost last
+  std::unordered_map<const void *, std::size_t> visited_;  // Bytes of each
+
+  Footprint total_;
+  Footprint shared_;
+
+  std::map<std::string, Footprint> files_;
+  std::map<std::string, Footprint> tags_;
+  std::map<std::string, Footprint> kinds_;
+
+  // Concrete methods
+  template<typename Visited, typename Func>
+  void visitShared(const Visited &visited, std::size_t size, Func &&func);
+
+  void account(const char *kind, std::size_t bytes, std::size_t objects = 1);
+  void accountString(const std::string &string);
+
+  template<typename T>
+  void accountVector(const std::vector<T> &vector);
+
+  template<typename Visited>
+  void accountInline(const Visited &visited);
+};
+
+}  // namespace lang
+
+#endif  // LANG_MODEL_CONFIG_PROFILER_
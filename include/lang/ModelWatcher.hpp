@@ -0,0 +1,82 @@
+/***********************************************************************/
+/*  Copyright 2016 ToPS                                                */
+/*                                                                     */
+/*  This program is free software; you can redistribute it and/or      */
+/*  modify it under the terms of the GNU  General Public License as    */
+/*  published by the Free Software Foundation; either version 3 of     */
+/*  the License, or (at your option) any later version.                */
+/*                                                                     */
+/*  This program is distributed in the hope that it will be useful,    */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of     */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the      */
+/*  GNU General Public License for more details.                       */
+/*                                                                     */
+/*  You should have received a copy of the GNU General Public License  */
+/*  along with this program; if not, write to the Free Software        */
+/*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,         */
+/*  MA 02110-1301, USA.                                                */
+/***********************************************************************/
+
+#ifndef LANG_MODEL_WATCHER_
+#define LANG_MODEL_WATCHER_
+
+// Standard headers
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+// Internal headers
+#include "lang/Interpreter.hpp"
+#include "lang/DependencyScanner.hpp"
+
+#include "config/ModelConfig.hpp"
+
+namespace lang {
+
+/**
+ * @class ModelWatcher
+ * @brief Keeps a model up to date with the files it is made of
+ *
+ * The files of the model are watched with inotify. When some of them
+ * change, only them and the files that depend on them are evaluated
+ * again; every other submodel is reused. The whole model is evaluated
+ * again when inotify drops events, or when a file of a model with dynamic
+ * references (see DependencyScanner) may have changed. The new model
+ * replaces the old one atomically, so model() can be called from other
+ * threads.
+ */
+class ModelWatcher {
+ public:
+  // Constructors
+  explicit ModelWatcher(const std::string &filepath);
+
+  ModelWatcher(const ModelWatcher &) = delete;
+  ModelWatcher &operator=(const ModelWatcher &) = delete;
+
+  // Concrete methods
+  config::ModelConfigPtr model() const;
+
+  std::vector<std::string> update(int timeout_ms = -1);
+
+  // Destructor
+  ~ModelWatcher();
+
+ private:
+  // Instance variables
+  std::string filepath_;
+  Interpreter interpreter_;
+  config::ModelConfigPtr model_;
+
+  int fd_;
+  std::map<int, std::string> watched_dirs_;
+  DependencyScanner::Graph graph_;
+
+  // Concrete methods
+  void reload(const std::set<std::string> &changed_files);
+  void watch();
+};
+
+}  // namespace lang
+
+#endif  // LANG_MODEL_WATCHER_
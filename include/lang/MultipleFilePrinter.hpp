@@ -21,18 +21,28 @@
 #define LANG_MULTIPLE_FILE_PRINTER_
 
 // Standard headers
+#include <map>
+#include <set>
 #include <list>
+#include <mutex>
+#include <memory>
 #include <string>
+#include <vector>
+#include <cstddef>
+#include <functional>
 
 // Internal headers
 #include "lang/FilePrinter.hpp"
 
+#include "config/Options.hpp"
 #include "config/ModelConfig.hpp"
 #include "config/StateConfig.hpp"
 #include "config/DurationConfig.hpp"
 #include "config/DependencyTreeConfig.hpp"
 #include "config/FeatureFunctionLibraryConfig.hpp"
 
+#include "concurrency/ThreadPool.hpp"
+
 namespace lang {
 
 /**
@@ -45,8 +55,32 @@ class MultipleFilePrinter : public FilePrinter {
   using Base = FilePrinter;
   using Self = MultipleFilePrinter;
 
+  // Inner structs
+  struct Statistics {
+    std::size_t files_written = 0;
+    std::size_t bytes_written = 0;
+    std::size_t files_avoided = 0;
+    std::size_t bytes_avoided = 0;
+  };
+
+  struct Context {
+    concurrency::ThreadPool *pool = nullptr;
+
+    mutable std::mutex mutex;
+    std::set<const void *> visited_configs;
+    std::map<std::string, std::size_t> written_paths;
+    std::map<std::string, std::size_t> avoided_paths;
+
+    bool claim(const void *config, const std::string &path);
+    void record(const std::string &path, std::size_t bytes);
+    Statistics statistics() const;
+  };
+
+  using ContextPtr = std::shared_ptr<Context>;
+
   // Constructors
   explicit MultipleFilePrinter(const std::string &root_dir);
+  MultipleFilePrinter(const std::string &root_dir, std::size_t num_threads);
 
   // Static methods
   template<typename... Args>
@@ -55,6 +89,8 @@ class MultipleFilePrinter : public FilePrinter {
   // Overriden methods
   void changeOstream(const std::string &path) override;
 
+  void print(const config::option::Probabilities &probabilities) override;
+
   void startPrinting() override;
   void endPrinting() override;
 
@@ -66,12 +102,20 @@ class MultipleFilePrinter : public FilePrinter {
 
   void print(config::DomainPtr domain_ptr) override;
 
+  // Concrete methods
+  Statistics statistics() const;
+
  protected:
   // Instance variables
   bool change_ostream_;
+  bool root_printer_;
+
+  ContextPtr context_;
+  std::unique_ptr<concurrency::ThreadPool> pool_;
 
   std::string root_dir_;
   std::string working_dir_;
+  std::string output_path_;
 
   std::list<config::ModelConfigPtr> submodels_;
   std::list<config::FeatureFunctionLibraryConfigPtr> libraries_;
@@ -81,15 +125,26 @@ class MultipleFilePrinter : public FilePrinter {
   template<typename... Args>
   MultipleFilePrinter(bool change_ostream,
                       const std::string &root_dir,
+                      ContextPtr context,
                       Args&&... args);
 
  private:
+  // Inner structs
+  struct TreeState {
+    unsigned int depth = 0;
+    std::vector<unsigned int> nodes { 1 };
+  };
+
   // Concrete methods
   std::string pathForHelperCall(const std::string &path);
+  std::string pathForOutput(const std::string &path);
+  std::string pathForTable(const std::string &tag);
+
+  void schedule(std::function<void()> task);
 
   void printSubmodel(config::ModelConfigPtr submodel_ptr);
   void printLibrary(config::FeatureFunctionLibraryConfigPtr library_ptr);
-  void printTree(config::DependencyTreeConfigPtr tree_ptr);
+  void printTree(config::DependencyTreeConfigPtr tree_ptr, TreeState &state);
 };
 
 }  // namespace lang
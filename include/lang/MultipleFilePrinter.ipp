@@ -30,9 +30,11 @@ namespace lang {
 
 template<typename... Args>
 MultipleFilePrinter::MultipleFilePrinter(
-    bool change_ostream, const std::string &root_dir, Args&&... args)
+    bool change_ostream, const std::string &root_dir, ContextPtr context,
+    Args&&... args)
     : Base(std::forward<Args>(args)...),
-      change_ostream_(change_ostream), root_dir_(root_dir) {
+      change_ostream_(change_ostream), root_printer_(false),
+      context_(context), root_dir_(root_dir) {
 }
 
 /*----------------------------------------------------------------------------*/
@@ -0,0 +1,80 @@
+/***********************************************************************/
+/*  Copyright 2016 ToPS                                                */
+/*                                                                     */
+/*  This program is free software; you can redistribute it and/or      */
+/*  modify it under the terms of the GNU  General Public License as    */
+/*  published by the Free Software Foundation; either version 3 of     */
+/*  the License, or (at your option) any later version.                */
+/*                                                                     */
+/*  This program is distributed in the hope that it will be useful,    */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of     */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the      */
+/*  GNU General Public License for more details.                       */
+/*                                                                     */
+/*  You should have received a copy of the GNU General Public License  */
+/*  along with this program; if not, write to the Free Software        */
+/*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,         */
+/*  MA 02110-1301, USA.                                                */
+/***********************************************************************/
+
+#ifndef LANG_OUTPUT_BUFFER_
+#define LANG_OUTPUT_BUFFER_
+
+// Standard headers
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <cstddef>
+
+namespace lang {
+
+/**
+ * @class OutputBuffer
+ * @brief Growable byte buffer in front of an output stream
+ *
+ * Printers append to the buffer without any iostream formatting. Bytes
+ * reach the stream in large blocks, and the stream is flushed only once,
+ * when the buffer is explicitly flushed or destroyed.
+ */
+class OutputBuffer {
+ public:
+  // Constructors
+  explicit OutputBuffer(std::shared_ptr<std::ostream> os);
+
+  // Concrete methods
+  OutputBuffer &operator<<(const std::string &string);
+  OutputBuffer &operator<<(const char *string);
+  OutputBuffer &operator<<(char c);
+  OutputBuffer &operator<<(unsigned int num);
+  OutputBuffer &operator<<(double num);
+  OutputBuffer &operator<<(bool boolean);
+
+  void append(const char *data, std::size_t size);
+  void appendSpaces(std::size_t count);
+
+  void flush();
+
+  std::size_t bytes() const;
+
+  // Destructor
+  ~OutputBuffer();
+
+ private:
+  // Instance variables
+  std::shared_ptr<std::ostream> os_;
+  std::string buffer_;
+  std::size_t bytes_;
+
+  // Concrete methods
+  void write();
+};
+
+/**
+ * @typedef OutputBufferPtr
+ * @brief Alias of pointer to OutputBuffer
+ */
+using OutputBufferPtr = std::shared_ptr<OutputBuffer>;
+
+}  // namespace lang
+
+#endif  // LANG_OUTPUT_BUFFER_
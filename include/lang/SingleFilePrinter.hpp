@@ -62,6 +62,10 @@ class SingleFilePrinter : public FilePrinter {
  protected:
   // Hidden constructor inheritance
   using Base::Base;
+
+ private:
+  // Instance variables
+  unsigned int tree_depth_ = 0;
 };
 
 }  // namespace lang
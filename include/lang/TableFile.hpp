@@ -0,0 +1,65 @@
+/***********************************************************************/
+/*  Copyright 2016 ToPS                                                */
+/*                                                                     */
+/*  This program is free software; you can redistribute it and/or      */
+/*  modify it under the terms of the GNU  General Public License as    */
+/*  published by the Free Software Foundation; either version 3 of     */
+/*  the License, or (at your option) any later version.                */
+/*                                                                     */
+/*  This program is distributed in the hope that it will be useful,    */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of     */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the      */
+/*  GNU General Public License for more details.                       */
+/*                                                                     */
+/*  You should have received a copy of the GNU General Public License  */
+/*  along with this program; if not, write to the Free Software        */
+/*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,         */
+/*  MA 02110-1301, USA.                                                */
+/***********************************************************************/
+
+#ifndef LANG_TABLE_FILE_
+#define LANG_TABLE_FILE_
+
+// Standard headers
+#include <string>
+#include <cstddef>
+
+// Internal headers
+#include "config/Options.hpp"
+
+namespace lang {
+
+/**
+ * @class TableFile
+ * @brief File with the entries of a config::option::Probabilities
+ *
+ * Each line has a key in the syntax `target | context` (or only `target`),
+ * a tab and a probability. Empty lines and lines starting with `#` are
+ * ignored. Files are mapped in memory and parsed in a single pass, so big
+ * tables are never copied as a whole.
+ */
+class TableFile {
+ public:
+  // Constructors
+  explicit TableFile(const std::string &filepath);
+
+  // Concrete methods
+  config::option::Probabilities read() const;
+  void read(config::option::Probabilities &table) const;
+
+  std::size_t write(const config::option::Probabilities &table) const;
+
+ private:
+  // Instance variables
+  std::string filepath_;
+
+  // Concrete methods
+  void parse(const char *data, std::size_t size,
+             config::option::Probabilities &table) const;
+
+  [[noreturn]] void invalid(std::size_t line, const std::string &reason) const;
+};
+
+}  // namespace lang
+
+#endif  // LANG_TABLE_FILE_
@@ -0,0 +1,109 @@
+/***********************************************************************/
+/*  Copyright 2016 ToPS                                                */
+/*                                                                     */
+/*  This program is free software; you can redistribute it and/or      */
+/*  modify it under the terms of the GNU  General Public License as    */
+/*  published by the Free Software Foundation; either version 3 of     */
+/*  the License, or (at your option) any later version.                */
+/*                                                                     */
+/*  This program is distributed in the hope that it will be useful,    */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of     */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the      */
+/*  GNU General Public License for more details.                       */
+/*                                                                     */
+/*  You should have received a copy of the GNU General Public License  */
+/*  along with this program; if not, write to the Free Software        */
+/*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,         */
+/*  MA 02110-1301, USA.                                                */
+/***********************************************************************/
+
+#ifndef LANG_TRACER_
+#define LANG_TRACER_
+
+// Standard headers
+#include <mutex>
+#include <chrono>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstddef>
+#include <unordered_map>
+
+namespace lang {
+
+/**
+ * @class Tracer
+ * @brief Recorder of nested time spans of the evaluation of models
+ *
+ * Spans are opened and closed by Tracer::Span objects. A span without
+ * tracer (when tracing is disabled) costs a single pointer comparison.
+ * Recorded spans can be exported in the Chrome trace event format (read
+ * by chrome://tracing and Perfetto) or summarized by file.
+ */
+class Tracer {
+ public:
+  // Inner structs
+  struct Event {
+    const char *name;    // Phase (string literal)
+    std::string file;
+    std::size_t thread;  // Sequential number of the thread
+    double start;        // Microseconds since the tracer was created
+    double duration;     // Microseconds
+  };
+
+  // Inner classes
+  class Span {
+   public:
+    // Constructors
+    Span(Tracer *tracer, const char *name, const std::string &file);
+    Span(const std::shared_ptr<Tracer> &tracer,
+         const char *name, const std::string &file);
+
+    Span(const Span &) = delete;
+    Span &operator=(const Span &) = delete;
+
+    // Destructor
+    ~Span();
+
+   private:
+    // Instance variables
+    Tracer *tracer_;
+    const char *name_;
+    std::string file_;
+    std::chrono::steady_clock::time_point start_;
+  };
+
+  // Constructors
+  Tracer();
+
+  // Concrete methods
+  std::vector<Event> events() const;
+
+  void writeChromeTrace(std::ostream &os) const;
+  void writeStatistics(std::ostream &os, std::size_t max_files) const;
+
+ private:
+  // Instance variables
+  std::chrono::steady_clock::time_point origin_;
+
+  mutable std::mutex mutex_;
+  std::vector<Event> events_;
+  std::unordered_map<std::thread::id, std::size_t> threads_;
+
+  // Concrete methods
+  void record(const char *name, std::string file,
+              std::chrono::steady_clock::time_point start,
+              std::chrono::steady_clock::time_point end);
+};
+
+/**
+ * @typedef TracerPtr
+ * @brief Alias of pointer to Tracer
+ */
+using TracerPtr = std::shared_ptr<Tracer>;
+
+}  // namespace lang
+
+#endif  // LANG_TRACER_
@@ -0,0 +1,87 @@
+/***********************************************************************/
+/*  Copyright 2016 ToPS                                                */
+/*                                                                     */
+/*  This program is free software; you can redistribute it and/or      */
+/*  modify it under the terms of the GNU  General Public License as    */
+/*  published by the Free Software Foundation; either version 3 of     */
+/*  the License, or (at your option) any later version.                */
+/*                                                                     */
+/*  This program is distributed in the hope that it will be useful,    */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of     */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the      */
+/*  GNU General Public License for more details.                       */
+/*                                                                     */
+/*  You should have received a copy of the GNU General Public License  */
+/*  along with this program; if not, write to the Free Software        */
+/*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,         */
+/*  MA 02110-1301, USA.                                                */
+/***********************************************************************/
+
+#ifndef MODEL_MULTI_SEQUENCE_
+#define MODEL_MULTI_SEQUENCE_
+
+// Standard headers
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+// Internal headers
+#include "model/Symbol.hpp"
+#include "model/Sequence.hpp"
+
+namespace model {
+
+/**
+ * @class MultiSequence
+ * @brief Aligned sequences of symbols, one track for each domain
+ *
+ * Tracks are stored apart from each other (structure of arrays), each one
+ * contiguous and with the smallest integer type (1, 2 or 4 bytes) able to
+ * hold its symbols. Tracks are widened as larger symbols are appended, so they
+ * do not need to know the size of their alphabets in advance.
+ */
+class MultiSequence {
+ public:
+  // Constructors
+  explicit MultiSequence(std::size_t number_of_tracks = 0);
+
+  // Concrete methods
+  void reserve(std::size_t length);
+  void push_back(const std::vector<Symbol> &row);
+
+  std::size_t size() const;
+  std::size_t tracks() const;
+  std::size_t width(std::size_t track) const;  // Bytes of each symbol
+
+  Symbol at(std::size_t track, std::size_t position) const;
+  Sequence sequence(std::size_t track) const;
+
+  // Calls func(const T *symbols, std::size_t size), with T as narrow as
+  // the track, so that it can be scanned with unit stride
+  template<typename Func>
+  void scan(std::size_t track, Func &&func) const;
+
+ private:
+  // Inner structs
+  // Only the vector matching the width holds symbols
+  struct Track {
+    std::size_t width = 1;
+    std::vector<std::uint8_t> narrow;
+    std::vector<std::uint16_t> medium;
+    std::vector<std::uint32_t> wide;
+  };
+
+  // Instance variables
+  std::vector<Track> tracks_;
+  std::size_t size_ = 0;
+
+  // Concrete methods
+  void widen(Track &track, std::size_t width);
+};
+
+}  // namespace model
+
+// Implementation header
+#include "model/MultiSequence.ipp"
+
+#endif  // MODEL_MULTI_SEQUENCE_
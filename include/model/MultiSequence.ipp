@@ -0,0 +1,49 @@
+/***********************************************************************/
+/*  Copyright 2016 ToPS                                                */
+/*                                                                     */
+/*  This program is free software; you can redistribute it and/or      */
+/*  modify it under the terms of the GNU  General Public License as    */
+/*  published by the Free Software Foundation; either version 3 of     */
+/*  the License, or (at your option) any later version.                */
+/*                                                                     */
+/*  This program is distributed in the hope that it will be useful,    */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of     */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the      */
+/*  GNU General Public License for more details.                       */
+/*                                                                     */
+/*  You should have received a copy of the GNU General Public License  */
+/*  along with this program; if not, write to the Free Software        */
+/*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,         */
+/*  MA 02110-1301, USA.                                                */
+/***********************************************************************/
+
+// Standard headers
+#include <cstddef>
+#include <cstdint>
+
+namespace model {
+
+/*----------------------------------------------------------------------------*/
+/*                              CONCRETE METHODS                              */
+/*----------------------------------------------------------------------------*/
+
+template<typename Func>
+void MultiSequence::scan(std::size_t track, Func &&func) const {
+  const auto &scanned = tracks_.at(track);
+
+  switch (scanned.width) {
+    case 1:
+      func(scanned.narrow.data(), size_);
+      break;
+    case 2:
+      func(scanned.medium.data(), size_);
+      break;
+    default:
+      func(scanned.wide.data(), size_);
+      break;
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+
+}  // namespace model
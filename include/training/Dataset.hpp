@@ -0,0 +1,55 @@
+/***********************************************************************/
+/*  Copyright 2016 ToPS                                                */
+/*                                                                     */
+/*  This program is free software; you can redistribute it and/or      */
+/*  modify it under the terms of the GNU  General Public License as    */
+/*  published by the Free Software Foundation; either version 3 of     */
+/*  the License, or (at your option) any later version.                */
+/*                                                                     */
+/*  This program is distributed in the hope that it will be useful,    */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of     */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the      */
+/*  GNU General Public License for more details.                       */
+/*                                                                     */
+/*  You should have received a copy of the GNU General Public License  */
+/*  along with this program; if not, write to the Free Software        */
+/*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,         */
+/*  MA 02110-1301, USA.                                                */
+/***********************************************************************/
+
+#ifndef TRAINING_DATASET_
+#define TRAINING_DATASET_
+
+// Standard headers
+#include <string>
+#include <vector>
+#include <istream>
+
+// Internal headers
+#include "config/Converter.hpp"
+
+#include "model/Sequence.hpp"
+#include "model/MultiSequence.hpp"
+
+namespace training {
+
+/**
+ * @typedef Dataset
+ * @brief Alias to a list of converted training sequences
+ */
+using Dataset = std::vector<model::Sequence>;
+
+// Dataset readers
+
+Dataset readFasta(const std::string &filepath,
+                  config::ConverterPtr converter);
+
+// One track for each converter, read from the tab-separated columns of
+// each line, in a single pass
+model::MultiSequence readTracks(std::istream &src,
+                                const std::vector<config::ConverterPtr>
+                                  &converters);
+
+}  // namespace training
+
+#endif  // TRAINING_DATASET_
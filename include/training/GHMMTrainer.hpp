@@ -0,0 +1,114 @@
+/***********************************************************************/
+/*  Copyright 2016 ToPS                                                */
+/*                                                                     */
+/*  This program is free software; you can redistribute it and/or      */
+/*  modify it under the terms of the GNU  General Public License as    */
+/*  published by the Free Software Foundation; either version 3 of     */
+/*  the License, or (at your option) any later version.                */
+/*                                                                     */
+/*  This program is distributed in the hope that it will be useful,    */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of     */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the      */
+/*  GNU General Public License for more details.                       */
+/*                                                                     */
+/*  You should have received a copy of the GNU General Public License  */
+/*  along with this program; if not, write to the Free Software        */
+/*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,         */
+/*  MA 02110-1301, USA.                                                */
+/***********************************************************************/
+
+#ifndef TRAINING_GHMM_TRAINER_
+#define TRAINING_GHMM_TRAINER_
+
+// Standard headers
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <functional>
+
+// Internal headers
+#include "config/Domain.hpp"
+#include "config/Options.hpp"
+#include "config/GHMMConfig.hpp"
+#include "config/ModelConfig.hpp"
+#include "config/DurationConfig.hpp"
+
+#include "training/Dataset.hpp"
+
+namespace training {
+
+/**
+ * @class GHMMTrainer
+ * @brief Maximum likelihood trainer for config::GHMMConfig
+ *
+ * A labeled TSV dataset (observation in the first column, label in the
+ * last one, blank lines between sequences) is read only once. In that
+ * pass, the trainer accumulates initial and transition counts between
+ * segments, a duration histogram per state and the emission training
+ * set of each state, which is spilled to disk when it grows too large.
+ * Emission and duration sub-trainers of all states then run in parallel.
+ */
+class GHMMTrainer {
+ public:
+  // Alias
+  using EmissionTrainer = std::function<
+    config::ModelConfigPtr(const Dataset &, const std::string &)>;
+
+  // Constructors
+  GHMMTrainer(config::option::Alphabet observations,
+              config::option::Alphabet labels,
+              double pseudo_counter = 0);
+
+  // Concrete methods
+  void setEmissionTrainer(const std::string &state, EmissionTrainer trainer);
+  void setGeometricDuration(const std::string &state);
+  void setSpilling(const std::string &spill_dir, std::size_t max_symbols);
+
+  config::GHMMConfigPtr train(const std::string &dataset_path,
+                              const std::string &filepath);
+
+ private:
+  // Inner structs
+  struct StateStatistics {
+    bool geometric = false;
+    EmissionTrainer emission_trainer;
+
+    std::vector<double> durations;
+
+    Dataset segments;
+    std::size_t buffered_symbols = 0;
+    std::size_t spilled_segments = 0;
+  };
+
+  // Instance variables
+  config::option::Alphabet observations_;
+  config::option::Alphabet labels_;
+  double pseudo_counter_;
+
+  std::string spill_dir_;
+  std::size_t max_buffered_symbols_;
+
+  std::vector<StateStatistics> states_;
+  std::vector<double> initial_counts_;
+  std::vector<std::vector<double>> transition_counts_;
+
+  // Concrete methods
+  void reset();
+  void closeSegment(model::Symbol label, model::Sequence &segment,
+                    int &previous_label);
+
+  std::string spillPath(model::Symbol label) const;
+  void spill(model::Symbol label);
+  Dataset loadSegments(model::Symbol label);
+
+  config::DurationConfigPtr trainDuration(model::Symbol label,
+                                          const std::string &filepath);
+
+  config::option::Probabilities
+  normalize(const std::vector<double> &counts,
+            const std::string &condition = "") const;
+};
+
+}  // namespace training
+
+#endif  // TRAINING_GHMM_TRAINER_
@@ -0,0 +1,62 @@
+/***********************************************************************/
+/*  Copyright 2016 ToPS                                                */
+/*                                                                     */
+/*  This program is free software; you can redistribute it and/or      */
+/*  modify it under the terms of the GNU  General Public License as    */
+/*  published by the Free Software Foundation; either version 3 of     */
+/*  the License, or (at your option) any later version.                */
+/*                                                                     */
+/*  This program is distributed in the hope that it will be useful,    */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of     */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the      */
+/*  GNU General Public License for more details.                       */
+/*                                                                     */
+/*  You should have received a copy of the GNU General Public License  */
+/*  along with this program; if not, write to the Free Software        */
+/*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,         */
+/*  MA 02110-1301, USA.                                                */
+/***********************************************************************/
+
+#ifndef TRAINING_IID_TRAINER_
+#define TRAINING_IID_TRAINER_
+
+// Standard headers
+#include <string>
+#include <vector>
+
+// Internal headers
+#include "config/Domain.hpp"
+#include "config/Options.hpp"
+#include "config/IIDConfig.hpp"
+
+#include "training/Dataset.hpp"
+
+namespace training {
+
+/**
+ * @class IIDTrainer
+ * @brief Maximum likelihood trainer for config::IIDConfig
+ */
+class IIDTrainer {
+ public:
+  // Constructors
+  explicit IIDTrainer(config::option::Alphabet alphabet,
+                      double pseudo_counter = 0);
+
+  // Concrete methods
+  config::IIDConfigPtr train(const Dataset &training_set,
+                             const std::string &filepath) const;
+
+  config::IIDConfigPtr train(const std::vector<double> &counts,
+                             const std::string &filepath) const;
+
+ private:
+  // Instance variables
+  config::option::Alphabet alphabet_;
+  config::option::Domain domain_;
+  double pseudo_counter_;
+};
+
+}  // namespace training
+
+#endif  // TRAINING_IID_TRAINER_
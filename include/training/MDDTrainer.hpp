@@ -0,0 +1,109 @@
+/***********************************************************************/
+/*  Copyright 2016 ToPS                                                */
+/*                                                                     */
+/*  This program is free software; you can redistribute it and/or      */
+/*  modify it under the terms of the GNU  General Public License as    */
+/*  published by the Free Software Foundation; either version 3 of     */
+/*  the License, or (at your option) any later version.                */
+/*                                                                     */
+/*  This program is distributed in the hope that it will be useful,    */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of     */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the      */
+/*  GNU General Public License for more details.                       */
+/*                                                                     */
+/*  You should have received a copy of the GNU General Public License  */
+/*  along with this program; if not, write to the Free Software        */
+/*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,         */
+/*  MA 02110-1301, USA.                                                */
+/***********************************************************************/
+
+#ifndef TRAINING_MDD_TRAINER_
+#define TRAINING_MDD_TRAINER_
+
+// Standard headers
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+// Internal headers
+#include "config/Domain.hpp"
+#include "config/Options.hpp"
+#include "config/MDDConfig.hpp"
+#include "config/ModelConfig.hpp"
+#include "config/DependencyTreeConfig.hpp"
+
+#include "training/Dataset.hpp"
+
+#include "concurrency/ThreadPool.hpp"
+
+namespace training {
+
+/**
+ * @class MDDTrainer
+ * @brief Trainer building a config::MDDConfig with Burge's algorithm
+ *
+ * Chi-square statistics between the consensus indicator of each position
+ * and the symbols of every other position are evaluated in parallel over a
+ * bit-sliced copy of the training set (one bit plane per position/symbol),
+ * sharing one pool of workers for every node of the tree.
+ * The resulting IR can be written with lang::ModelConfigSerializer using a
+ * root directory, which creates the MDD file, its dependency tree and the
+ * models of every node through lang::MultipleFilePrinter.
+ */
+class MDDTrainer {
+ public:
+  // Alias
+  using Bitset = std::vector<std::uint64_t>;
+
+  // Constructors
+  MDDTrainer(config::option::Alphabet alphabet,
+             std::vector<config::option::Symbol> consensus_sequence,
+             unsigned int minimum_subset);
+
+  // Concrete methods
+  config::MDDConfigPtr train(const Dataset &training_set,
+                             const std::string &filepath);
+
+ private:
+  // Inner structs
+  struct Split {
+    std::size_t position = 0;
+    double statistic = 0;
+    bool significant = false;
+  };
+
+  // Instance variables
+  config::option::Alphabet alphabet_;
+  config::option::Domain domain_;
+  std::vector<std::vector<model::Symbol>> consensus_;
+  unsigned int minimum_subset_;
+  double critical_value_;
+
+  std::vector<std::vector<Bitset>> planes_;
+  std::vector<Bitset> consensus_planes_;
+
+  std::string root_dir_;
+  std::string tree_path_;
+  unsigned int next_node_;
+
+  concurrency::ThreadPool pool_;
+
+  // Concrete methods
+  void sliceTrainingSet(const Dataset &training_set);
+
+  config::DependencyTreeConfigPtr makeNode(const Bitset &subset,
+                                           std::vector<bool> used);
+  config::DependencyTreeConfigPtr makeLeaf(const Bitset &subset);
+
+  Split findSplit(const Bitset &subset, const std::vector<bool> &used);
+  double chiSquare(std::size_t i, std::size_t j, const Bitset &subset,
+                   double total, double consensus_total) const;
+
+  config::ModelConfigPtr trainModel(const Bitset &subset);
+  config::option::Pattern consensusPattern() const;
+};
+
+}  // namespace training
+
+#endif  // TRAINING_MDD_TRAINER_
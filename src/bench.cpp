@@ -0,0 +1,453 @@
+/***********************************************************************/
+/*  Copyright 2016 ToPS                                                */
+/*                                                                     */
+/*  This program is free software; you can redistribute it and/or      */
+/*  modify it under the terms of the GNU  General Public License as    */
+/*  published by the Free Software Foundation; either version 3 of     */
+/*  the License, or (at your option) any later version.                */
+/*                                                                     */
+/*  This program is distributed in the hope that it will be useful,    */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of     */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the      */
+/*  GNU General Public License for more details.                       */
+/*                                                                     */
+/*  You should have received a copy of the GNU General Public License  */
+/*  along with this program; if not, write to the Free Software        */
+/*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,         */
+/*  MA 02110-1301, USA.                                                */
+/***********************************************************************/
+
+// Standard headers
+#include <map>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <iterator>
+#include <utility>
+#include <iostream>
+#include <algorithm>
+#include <exception>
+#include <functional>
+
+// Internal headers
+#include "config/Domain.hpp"
+#include "config/Options.hpp"
+#include "config/Converter.hpp"
+
+#include "lang/Util.hpp"
+#include "lang/Interpreter.hpp"
+#include "lang/DependencyTreeParser.hpp"
+#include "lang/MultipleFilePrinter.hpp"
+#include "lang/ModelConfigSerializer.hpp"
+
+#include "filesystem/Filesystem.hpp"
+
+/*
+\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\
+ -------------------------------------------------------------------------------
+                                    HARNESS
+ -------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
+*/
+
+struct Result {
+  std::string name;
+  std::size_t iterations;
+  double real_time_ns;      // Median of all iterations
+  double items_per_second;  // Zero when the case has no natural unit
+};
+
+/*----------------------------------------------------------------------------*/
+
+struct Options {
+  std::string root_dir;
+  std::string work_dir = "bench.tmp/";
+  std::string filter;
+  std::string baseline;
+  double threshold = 10.0;  // Percentage of slowdown flagged as regression
+};
+
+/*----------------------------------------------------------------------------*/
+
+// Results of computations that would otherwise be optimized away
+static volatile std::size_t sink;
+
+/*----------------------------------------------------------------------------*/
+
+static bool selected(const Options &options, const std::string &name) {
+  return name.find(options.filter) != std::string::npos;
+}
+
+/*----------------------------------------------------------------------------*/
+
+// Each case runs once to warm up, then until it took at least min_seconds
+// (and no less than min_iterations times). The median is robust to the
+// occasional iteration slowed down by the rest of the system.
+static const double min_seconds = 0.5;
+static const std::size_t min_iterations = 5;
+static const std::size_t max_iterations = 100000;
+
+static void measure(const Options &options,
+                    std::vector<Result> &results,
+                    const std::string &name,
+                    std::size_t items,
+                    std::function<void()> iteration) {
+  if (!selected(options, name)) return;
+
+  using Clock = std::chrono::steady_clock;
+
+  iteration();
+
+  std::vector<double> times;
+  double total = 0;
+  while ((total < min_seconds || times.size() < min_iterations)
+         && times.size() < max_iterations) {
+    auto start = Clock::now();
+    iteration();
+    auto end = Clock::now();
+
+    times.push_back(std::chrono::duration<double>(end - start).count());
+    total += times.back();
+  }
+
+  std::sort(times.begin(), times.end());
+  double median = times[times.size() / 2];
+
+  results.push_back({ name, times.size(), median * 1e9,
+                      items ? static_cast<double>(items) / median : 0 });
+
+  std::cerr << name << ": " << median * 1e3 << " ms ("
+            << times.size() << " iterations)" << std::endl;
+}
+
+/*
+\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\
+ -------------------------------------------------------------------------------
+                                   BENCHMARKS
+ -------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
+*/
+
+// Main models of the examples, relative to the root of the repository
+static const std::vector<std::string> models {
+  "script/models/hmm.tops",
+  "script/models/iid.tops",
+  "script/models/imc.tops",
+  "script/models/msm.tops",
+  "script/models/sbsw.tops",
+  "script/models/vlmc.tops",
+  "script/models/periodic_imc.tops",
+  "script/models/ghmm/cassino.tops",
+  "script/models/lccrf/cassino.tops",
+  "script/models/mdd/mdd.tops",
+  "script/bacterial_genome/bacterial_genome.tops"
+};
+
+/*----------------------------------------------------------------------------*/
+/*                                    LOAD                                    */
+/*----------------------------------------------------------------------------*/
+
+static void benchmarkLoad(const Options &options,
+                          std::vector<Result> &results) {
+  for (const auto &model : models) {
+    auto filepath = options.root_dir + model;
+    measure(options, results, "load/" + model, 0, [&filepath] {
+      lang::Interpreter().evalModel(filepath);
+    });
+
+    measure(options, results, "load_arena/" + model, 0, [&filepath] {
+      lang::Interpreter interpreter;
+      interpreter.setArena(true);
+      interpreter.evalModel(filepath);
+    });
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+/*                                 CONVERSION                                 */
+/*----------------------------------------------------------------------------*/
+
+static void benchmarkConversion(const Options &options,
+                                std::vector<Result> &results) {
+  std::ifstream dataset(options.root_dir + "data/dna.tsv");
+
+  std::vector<std::pair<std::string, std::string>> rows;
+  config::option::Alphabet labels;
+
+  std::string line;
+  std::getline(dataset, line);  // Header
+  while (std::getline(dataset, line)) {
+    auto tab = line.find('\t');
+    rows.emplace_back(line.substr(0, tab), line.substr(tab + 1));
+    if (std::find(labels.begin(), labels.end(), rows.back().second)
+        == labels.end())
+      labels.push_back(rows.back().second);
+  }
+
+  using discrete_domain = config::Domain::discrete_domain;
+  auto nucleotides = config::Domain(discrete_domain{},
+                                    { "A", "C", "G", "T" }).makeConverter();
+  auto annotations = config::Domain(discrete_domain{},
+                                    labels).makeConverter();
+
+  measure(options, results, "convert/data/dna.tsv", rows.size(), [&] {
+    std::size_t checksum = 0;
+    for (const auto &row : rows)
+      checksum += nucleotides->convert(row.first)
+                + annotations->convert(row.second);
+    sink = checksum;
+  });
+}
+
+/*----------------------------------------------------------------------------*/
+/*                               SERIALIZATION                                */
+/*----------------------------------------------------------------------------*/
+
+static void benchmarkSerialization(const Options &options,
+                                   std::vector<Result> &results) {
+  for (const auto &model : models) {
+    if (!selected(options, "serialize/single/" + model)
+        && !selected(options, "serialize/multiple/" + model))
+      continue;
+
+    auto model_cfg = lang::Interpreter().evalModel(options.root_dir + model);
+
+    measure(options, results, "serialize/single/" + model, 0, [&model_cfg] {
+      std::ostringstream os;
+      model_cfg->accept(lang::ModelConfigSerializer(os));
+    });
+
+    auto output_dir = options.work_dir + "serialize/";
+    measure(options, results, "serialize/multiple/" + model, 0,
+            [&model_cfg, &output_dir] {
+      auto printer = std::make_shared<lang::MultipleFilePrinter>(output_dir);
+      model_cfg->accept(lang::ModelConfigSerializer(printer));
+    });
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+/*                              DEPENDENCY TREES                              */
+/*----------------------------------------------------------------------------*/
+
+static void benchmarkDependencyTrees(const Options &options,
+                                     std::vector<Result> &results) {
+  std::string dir = "script/models/mdd/";
+  std::string file = "dependency.tree";
+
+  // Cases are named relative to --root, so that baselines stay comparable
+  auto root_dir = options.root_dir + dir;
+
+  std::ifstream src(root_dir + file);
+  std::vector<std::string> content;
+  for (std::string line; std::getline(src, line); )
+    content.push_back(line);
+
+  // Models of the nodes are evaluated once, so that only parsing is measured
+  lang::Interpreter interpreter;
+  interpreter.setMemoize(true);
+
+  measure(options, results, "parse/" + dir + file, content.size(),
+          [&] {
+    lang::DependencyTreeParser(&interpreter, root_dir, file, content).parse();
+  });
+}
+
+/*----------------------------------------------------------------------------*/
+/*                                  LITERALS                                  */
+/*----------------------------------------------------------------------------*/
+
+// IID model with `size` symbols and as many emission probabilities.
+// A single `var` declaration forces the file to be evaluated by ChaiScript.
+static void writeLiteralsModel(const std::string &filepath,
+                               std::size_t size, bool chaiscript) {
+  std::ofstream dst(filepath);
+
+  dst << "model_type = \"IID\"\n";
+  if (chaiscript) dst << "var unused = 0\n";
+
+  dst << "observations = [\n";
+  for (std::size_t i = 0; i < size; i++)
+    dst << "  \"s" << i << "\"" << (i + 1 < size ? ",\n" : "\n");
+  dst << "]\n";
+
+  dst << "emission_probabilities = [\n";
+  for (std::size_t i = 0; i < size; i++)
+    dst << "  \"s" << i << "\" : " << 1.0 / static_cast<double>(size)
+        << (i + 1 < size ? ",\n" : "\n");
+  dst << "]\n";
+}
+
+/*----------------------------------------------------------------------------*/
+
+static void benchmarkLiterals(const Options &options,
+                              std::vector<Result> &results,
+                              std::size_t size, bool chaiscript) {
+  auto name = chaiscript ? "literals/chaiscript" : "literals/declarative";
+  if (!selected(options, name)) return;
+
+  auto filepath = options.work_dir + (chaiscript ? "literals_chaiscript.tops"
+                                                 : "literals_declarative.tops");
+  writeLiteralsModel(filepath, size, chaiscript);
+
+  measure(options, results, name, size, [&filepath] {
+    lang::Interpreter().evalModel(filepath);
+  });
+}
+
+/*
+\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\
+ -------------------------------------------------------------------------------
+                                    RESULTS
+ -------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
+*/
+
+static void writeResults(const std::vector<Result> &results,
+                         std::ostream &os) {
+  os << "{\n  \"benchmarks\": [";
+  for (std::size_t i = 0; i < results.size(); i++) {
+    const auto &result = results[i];
+    os << (i == 0 ? "\n" : ",\n")
+       << "    {\n"
+       << "      \"name\": \"" << result.name << "\",\n"
+       << "      \"iterations\": " << result.iterations << ",\n"
+       << "      \"real_time_ns\": "
+       << std::to_string(result.real_time_ns) << ",\n"
+       << "      \"items_per_second\": "
+       << std::to_string(result.items_per_second) << "\n"
+       << "    }";
+  }
+  os << "\n  ]\n}" << std::endl;
+}
+
+/*----------------------------------------------------------------------------*/
+
+// Reads back the times written by writeResults, indexed by name. Only the
+// fields of that format are recognized, not JSON in general.
+static std::map<std::string, double> readBaseline(const std::string &path) {
+  std::ifstream src(path);
+  if (!src) throw std::invalid_argument("Could not open baseline " + path);
+
+  std::string content { std::istreambuf_iterator<char>(src),
+                        std::istreambuf_iterator<char>() };
+
+  std::map<std::string, double> baseline;
+
+  auto field = [&content] (const std::string &key, std::size_t from) {
+    auto found = content.find("\"" + key + "\":", from);
+    return found == std::string::npos ? found : found + key.size() + 3;
+  };
+
+  for (auto pos = field("name", 0); pos != std::string::npos;
+       pos = field("name", pos)) {
+    auto begin = content.find('"', pos) + 1;
+    auto end = content.find('"', begin);
+    auto name = content.substr(begin, end - begin);
+
+    auto time = field("real_time_ns", end);
+    if (time == std::string::npos) break;
+    baseline[name] = std::strtod(content.c_str() + time, nullptr);
+    pos = time;
+  }
+
+  return baseline;
+}
+
+/*----------------------------------------------------------------------------*/
+
+static bool compareResults(const std::vector<Result> &results,
+                           const std::map<std::string, double> &baseline,
+                           double threshold) {
+  bool regressed = false;
+
+  for (const auto &result : results) {
+    auto it = baseline.find(result.name);
+    if (it == baseline.end() || it->second <= 0) {
+      std::cerr << "  new        " << result.name << std::endl;
+      continue;
+    }
+
+    double change = 100.0 * (result.real_time_ns - it->second) / it->second;
+    bool slower = change > threshold;
+    regressed = regressed || slower;
+
+    std::ostringstream percentage;
+    percentage.precision(1);
+    percentage << std::fixed << std::showpos << change << "%";
+
+    std::cerr << (slower ? "  REGRESSED " : "  ok        ")
+              << result.name << " " << percentage.str() << std::endl;
+  }
+
+  return !regressed;
+}
+
+/*
+\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\
+ -------------------------------------------------------------------------------
+                                      MAIN
+ -------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
+*/
+
+int main(int argc, char **argv) try {
+  Options options;
+
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    bool has_value = i + 1 < argc;
+
+    if (arg == "--root" && has_value) {
+      options.root_dir = argv[++i];
+    } else if (arg == "--filter" && has_value) {
+      options.filter = argv[++i];
+    } else if (arg == "--compare" && has_value) {
+      options.baseline = argv[++i];
+    } else if (arg == "--threshold" && has_value) {
+      options.threshold = std::strtod(argv[++i], nullptr);
+    } else if (arg[0] != '-') {
+      options.work_dir = arg;
+    } else {
+      std::cerr << "USAGE: " << argv[0]
+                << " [--root repo_dir] [--filter substring]"
+                << " [--compare baseline.json] [--threshold percent]"
+                << " [work_dir]" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Paths starting with "./" are not handled by lang::extractDir
+  if (options.root_dir == ".") options.root_dir.clear();
+  while (options.root_dir.compare(0, 2, "./") == 0)
+    options.root_dir.erase(0, 2);
+  if (!options.root_dir.empty() && options.root_dir.back() != '/')
+    options.root_dir += '/';
+  if (options.work_dir.back() != '/') options.work_dir += '/';
+  filesystem::create_directories(options.work_dir);
+
+  std::vector<Result> results;
+  benchmarkLoad(options, results);
+  benchmarkConversion(options, results);
+  benchmarkSerialization(options, results);
+  benchmarkDependencyTrees(options, results);
+  benchmarkLiterals(options, results, 100000, false);
+  benchmarkLiterals(options, results, 100000, true);
+
+  // Results go to stdout, so that they can be stored as the next baseline
+  writeResults(results, std::cout);
+
+  if (options.baseline.empty()) return EXIT_SUCCESS;
+
+  std::cerr << "Comparison with " << options.baseline
+            << " (threshold " << options.threshold << "%):" << std::endl;
+  return compareResults(results, readBaseline(options.baseline),
+                        options.threshold) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+catch(std::exception &e) {
+  std::cerr << e.what() << std::endl;
+  return EXIT_FAILURE;
+}
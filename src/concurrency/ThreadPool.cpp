@@ -0,0 +1,125 @@
+/***********************************************************************/
+/*  Copyright 2016 ToPS                                                */
+/*                                                                     */
+/*  This program is free software; you can redistribute it and/or      */
+/*  modify it under the terms of the GNU  General Public License as    */
+/*  published by the Free Software Foundation; either version 3 of     */
+/*  the License, or (at your option) any later version.                */
+/*                                                                     */
+/*  This program is distributed in the hope that it will be useful,    */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of     */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the      */
+/*  GNU General Public License for more details.                       */
+/*                                                                     */
+/*  You should have received a copy of the GNU General Public License  */
+/*  along with this program; if not, write to the Free Software        */
+/*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,         */
+/*  MA 02110-1301, USA.                                                */
+/***********************************************************************/
+
+// Interface header
+#include "concurrency/ThreadPool.hpp"
+
+// Standard headers
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <algorithm>
+#include <exception>
+
+namespace concurrency {
+
+/*----------------------------------------------------------------------------*/
+/*                                CONSTRUCTORS                                */
+/*----------------------------------------------------------------------------*/
+
+ThreadPool::ThreadPool(std::size_t num_threads)
+    : pending_(0), stopping_(false) {
+  if (num_threads == 0)
+    num_threads = std::max(1u, std::thread::hardware_concurrency());
+
+  for (std::size_t t = 0; t < num_threads; t++)
+    workers_.emplace_back([this] { this->work(); });
+}
+
+/*----------------------------------------------------------------------------*/
+/*                              CONCRETE METHODS                              */
+/*----------------------------------------------------------------------------*/
+
+void ThreadPool::enqueue(std::function<void()> task) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tasks_.push(std::move(task));
+    pending_++;
+  }
+  task_available_.notify_one();
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ThreadPool::wait() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  tasks_done_.wait(lock, [this] { return pending_ == 0; });
+
+  if (error_) {
+    auto error = error_;
+    error_ = nullptr;
+    std::rethrow_exception(error);
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+
+std::size_t ThreadPool::size() const {
+  return workers_.size();
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ThreadPool::work() {
+  while (true) {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      task_available_.wait(lock, [this] {
+        return stopping_ || !tasks_.empty(); });
+
+      if (tasks_.empty()) return;
+
+      task = std::move(tasks_.front());
+      tasks_.pop();
+    }
+
+    std::exception_ptr error;
+    try {
+      task();
+    } catch (...) {
+      error = std::current_exception();
+    }
+    task = nullptr;
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (error && !error_) error_ = error;
+      if (--pending_ == 0) tasks_done_.notify_all();
+    }
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+/*                                 DESTRUCTOR                                 */
+/*----------------------------------------------------------------------------*/
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  task_available_.notify_all();
+
+  for (auto &worker : workers_) worker.join();
+}
+
+/*----------------------------------------------------------------------------*/
+
+}  // namespace concurrency
@@ -0,0 +1,109 @@
+/***********************************************************************/
+/*  Copyright 2016 ToPS                                                */
+/*                                                                     */
+/*  This program is free software; you can redistribute it and/or      */
+/*  modify it under the terms of the GNU  General Public License as    */
+/*  published by the Free Software Foundation; either version 3 of     */
+/*  the License, or (at your option) any later version.                */
+/*                                                                     */
+/*  This program is distributed in the hope that it will be useful,    */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of     */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the      */
+/*  GNU General Public License for more details.                       */
+/*                                                                     */
+/*  You should have received a copy of the GNU General Public License  */
+/*  along with this program; if not, write to the Free Software        */
+/*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,         */
+/*  MA 02110-1301, USA.                                                */
+/***********************************************************************/
+
+// Interface header
+#include "config/Arena.hpp"
+
+// Standard headers
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <algorithm>
+
+namespace config {
+
+/*----------------------------------------------------------------------------*/
+/*                               LOCAL VARIABLES                              */
+/*----------------------------------------------------------------------------*/
+
+// Arena of the innermost scope opened by this thread
+static thread_local ArenaPtr current_arena;
+
+/*----------------------------------------------------------------------------*/
+/*                                INNER CLASSES                               */
+/*----------------------------------------------------------------------------*/
+
+Arena::Scope::Scope() : previous_(current_arena) {
+  if (!current_arena) current_arena = std::make_shared<Arena>();
+}
+
+/*----------------------------------------------------------------------------*/
+
+Arena::Scope::Scope(ArenaPtr arena) : previous_(current_arena) {
+  current_arena = std::move(arena);
+}
+
+/*----------------------------------------------------------------------------*/
+
+Arena::Scope::~Scope() {
+  current_arena = std::move(previous_);
+}
+
+/*----------------------------------------------------------------------------*/
+/*                                CONSTRUCTORS                                */
+/*----------------------------------------------------------------------------*/
+
+Arena::Arena(std::size_t block_size) : block_size_(block_size) {
+}
+
+/*----------------------------------------------------------------------------*/
+/*                               STATIC METHODS                               */
+/*----------------------------------------------------------------------------*/
+
+const ArenaPtr &Arena::current() {
+  return current_arena;
+}
+
+/*----------------------------------------------------------------------------*/
+/*                              CONCRETE METHODS                              */
+/*----------------------------------------------------------------------------*/
+
+void *Arena::allocate(std::size_t size, std::size_t alignment) {
+  auto address = reinterpret_cast<std::uintptr_t>(position_);
+  auto padding = (alignment - address % alignment) % alignment;
+
+  if (position_ == nullptr || padding + size > available_) {
+    // Objects larger than a block get a block of their own
+    auto new_block_size = std::max(block_size_, size + alignment);
+    blocks_.emplace_back(new char[new_block_size]);
+    allocated_ += new_block_size;
+
+    position_ = blocks_.back().get();
+    available_ = new_block_size;
+
+    address = reinterpret_cast<std::uintptr_t>(position_);
+    padding = (alignment - address % alignment) % alignment;
+  }
+
+  auto pointer = position_ + padding;
+  position_ += padding + size;
+  available_ -= padding + size;
+  return pointer;
+}
+
+/*----------------------------------------------------------------------------*/
+
+std::size_t Arena::allocated() const {
+  return allocated_;
+}
+
+/*----------------------------------------------------------------------------*/
+
+}  // namespace config
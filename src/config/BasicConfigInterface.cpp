@@ -31,33 +31,23 @@ namespace config {
 
 BasicConfigInterface::BasicConfigInterface(const std::string &path,
                                            const std::string &label)
-    : path_(path), label_(label) {
+    : symbols_(SymbolTable::current()),
+      path_(symbols_->intern(path)),
+      label_(symbols_->intern(label)) {
 }
 
 /*----------------------------------------------------------------------------*/
 /*                              VIRTUAL METHODS                               */
 /*----------------------------------------------------------------------------*/
 
-std::string BasicConfigInterface::path() {
-  return path_;
+const std::string &BasicConfigInterface::path() const {
+  return path_.str();
 }
 
 /*----------------------------------------------------------------------------*/
 
-const std::string BasicConfigInterface::path() const {
-  return path_;
-}
-
-/*----------------------------------------------------------------------------*/
-
-std::string BasicConfigInterface::label() {
-  return label_;
-}
-
-/*----------------------------------------------------------------------------*/
-
-const std::string BasicConfigInterface::label() const {
-  return label_;
+const std::string &BasicConfigInterface::label() const {
+  return label_.str();
 }
 
 /*----------------------------------------------------------------------------*/
@@ -0,0 +1,166 @@
+/***********************************************************************/
+/*  Copyright 2016 ToPS                                                */
+/*                                                                     */
+/*  This program is free software; you can redistribute it and/or      */
+/*  modify it under the terms of the GNU  General Public License as    */
+/*  published by the Free Software Foundation; either version 3 of     */
+/*  the License, or (at your option) any later version.                */
+/*                                                                     */
+/*  This program is distributed in the hope that it will be useful,    */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of     */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the      */
+/*  GNU General Public License for more details.                       */
+/*                                                                     */
+/*  You should have received a copy of the GNU General Public License  */
+/*  along with this program; if not, write to the Free Software        */
+/*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,         */
+/*  MA 02110-1301, USA.                                                */
+/***********************************************************************/
+
+// Interface header
+#include "config/Condition.hpp"
+
+// Standard headers
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+
+namespace config {
+
+/*----------------------------------------------------------------------------*/
+/*                               LOCAL VARIABLES                              */
+/*----------------------------------------------------------------------------*/
+
+static const char separator[] = " | ";
+
+/*----------------------------------------------------------------------------*/
+/*                                CONSTRUCTORS                                */
+/*----------------------------------------------------------------------------*/
+
+Condition::Condition(const std::string &target)
+    : symbols_ { SymbolTable::current()->intern(target) } {
+}
+
+/*----------------------------------------------------------------------------*/
+
+Condition::Condition(const std::string &target, const std::string &context)
+    : Condition(target.data(), target.size(), context.data(), context.size()) {
+}
+
+/*----------------------------------------------------------------------------*/
+
+Condition::Condition(const char *target, std::size_t target_size,
+                     const char *context, std::size_t context_size)
+    : conditional_(true) {
+  auto end = context + context_size;
+  symbols_.reserve(2 + static_cast<std::size_t>(std::count(context, end, ' ')));
+
+  auto &table = SymbolTable::current();
+  symbols_.push_back(table->intern(target, target_size));
+
+  // Empty symbols are kept, so that str() reproduces the context exactly
+  if (context_size == 0) return;
+
+  for (auto begin = context; ; ) {
+    auto space = std::find(begin, end, ' ');
+    symbols_.push_back(table->intern(
+        begin, static_cast<std::size_t>(space - begin)));
+    if (space == end) break;
+    begin = space + 1;
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+/*                               STATIC METHODS                               */
+/*----------------------------------------------------------------------------*/
+
+Condition Condition::parse(const std::string &key) {
+  auto found = key.find(separator);
+  if (found == std::string::npos) return Condition(key);
+
+  auto context_begin = found + sizeof(separator) - 1;
+  return Condition(key.data(), found,
+                   key.data() + context_begin, key.size() - context_begin);
+}
+
+/*----------------------------------------------------------------------------*/
+/*                              CONCRETE METHODS                              */
+/*----------------------------------------------------------------------------*/
+
+Condition::Symbol Condition::target() const {
+  return symbols_.front();
+}
+
+/*----------------------------------------------------------------------------*/
+
+std::vector<Condition::Symbol> Condition::context() const {
+  return { symbols_.begin() + 1, symbols_.end() };
+}
+
+/*----------------------------------------------------------------------------*/
+
+bool Condition::conditional() const {
+  return conditional_;
+}
+
+/*----------------------------------------------------------------------------*/
+
+std::size_t Condition::capacity() const {
+  return symbols_.capacity();
+}
+
+/*----------------------------------------------------------------------------*/
+
+std::string Condition::str() const {
+  std::string string = symbols_.front().str();
+  if (!conditional_) return string;
+
+  string += separator;
+  for (std::size_t i = 1; i < symbols_.size(); i++) {
+    if (i > 1) string += ' ';
+    string += symbols_[i].str();
+  }
+  return string;
+}
+
+/*----------------------------------------------------------------------------*/
+
+std::size_t Condition::hash() const {
+  // FNV-1a over the hashes of the symbols, which do not depend on their
+  // tables, with the separator as an extra symbol
+  std::uint64_t hash = 14695981039346656037ULL;
+  for (const auto &symbol : symbols_) {
+    hash ^= symbol.hash();
+    hash *= 1099511628211ULL;
+  }
+  if (conditional_) {
+    hash ^= 0xffffffffULL;
+    hash *= 1099511628211ULL;
+  }
+  return static_cast<std::size_t>(hash);
+}
+
+/*----------------------------------------------------------------------------*/
+
+bool Condition::operator==(const Condition &rhs) const {
+  return conditional_ == rhs.conditional_ && symbols_ == rhs.symbols_;
+}
+
+/*----------------------------------------------------------------------------*/
+
+bool Condition::operator!=(const Condition &rhs) const {
+  return !(*this == rhs);
+}
+
+/*----------------------------------------------------------------------------*/
+
+bool Condition::operator<(const Condition &rhs) const {
+  if (conditional_ != rhs.conditional_) return !conditional_;
+  return symbols_ < rhs.symbols_;
+}
+
+/*----------------------------------------------------------------------------*/
+
+}  // namespace config
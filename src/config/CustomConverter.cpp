@@ -21,7 +21,9 @@
 #include "config/CustomConverter.hpp"
 
 // Standard headers
+#include <mutex>
 #include <utility>
+#include <shared_mutex>
 
 namespace config {
 
@@ -30,23 +32,69 @@ namespace config {
 /*----------------------------------------------------------------------------*/
 
 CustomConverter::CustomConverter(OutToInFunction out_to_in,
-                                 InToOutFunction in_to_out)
+                                 InToOutFunction in_to_out,
+                                 std::size_t max_cached)
     : out_to_in_(std::move(out_to_in)),
-      in_to_out_(std::move(in_to_out)) {
+      in_to_out_(std::move(in_to_out)),
+      max_cached_(max_cached) {
+}
+
+/*----------------------------------------------------------------------------*/
+
+CustomConverter::CustomConverter(OutToInFunction out_to_in,
+                                 InToOutFunction in_to_out,
+                                 const option::Alphabet &alphabet,
+                                 std::size_t max_cached)
+    : CustomConverter(std::move(out_to_in), std::move(in_to_out),
+                      max_cached + alphabet.size()) {
+  // Symbols declared in advance never go through the functions again
+  for (const auto &symbol : alphabet)
+    convert(convert(symbol));
 }
 
 /*----------------------------------------------------------------------------*/
 /*                             OVERRIDEN METHODS                              */
 /*----------------------------------------------------------------------------*/
 
-model::Symbol CustomConverter::convert(const option::Symbol &orig) const {
-  return out_to_in_(orig);
+model::Symbol CustomConverter::convert(const std::string &orig) const {
+  {
+    std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+    auto it = out_to_in_cache_.find(orig);
+    if (it != out_to_in_cache_.end()) return it->second;
+  }
+
+  auto converted = out_to_in_(orig);
+
+  std::lock_guard<std::shared_timed_mutex> lock(mutex_);
+  if (out_to_in_cache_.size() < max_cached_)
+    out_to_in_cache_.emplace(orig, converted);
+
+  return converted;
 }
 
 /*----------------------------------------------------------------------------*/
 
-option::Symbol CustomConverter::convert(const model::Symbol &orig) const {
-  return in_to_out_(orig);
+std::string CustomConverter::convert(const model::Symbol &orig) const {
+  {
+    std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+    if (orig < in_to_out_cached_.size() && in_to_out_cached_[orig])
+      return in_to_out_cache_[orig];
+  }
+
+  auto converted = in_to_out_(orig);
+
+  // Inner symbols index a dense table, so only small ones are remembered
+  std::lock_guard<std::shared_timed_mutex> lock(mutex_);
+  if (orig < max_cached_) {
+    if (orig >= in_to_out_cached_.size()) {
+      in_to_out_cache_.resize(orig + 1);
+      in_to_out_cached_.resize(orig + 1);
+    }
+    in_to_out_cache_[orig] = converted;
+    in_to_out_cached_[orig] = true;
+  }
+
+  return converted;
 }
 
 /*----------------------------------------------------------------------------*/
@@ -26,27 +26,26 @@ namespace config {
 /*                                CONSTRUCTORS                                */
 /*----------------------------------------------------------------------------*/
 
-DiscreteConverter::DiscreteConverter(const option::Alphabet &alphabet) {
-  model::Symbol i = 0;
+DiscreteConverter::DiscreteConverter(const option::Alphabet &alphabet)
+    : in_to_out_(alphabet) {
+  out_to_in_.reserve(alphabet.size());
 
-  for (const option::Symbol &s : alphabet) {
-    out_to_in_[s] = i;
-    in_to_out_[i] = s;
-    ++i;
-  }
+  model::Symbol i = 0;
+  for (const option::Symbol &s : alphabet)
+    out_to_in_[s] = i++;
 }
 
 /*----------------------------------------------------------------------------*/
 /*                             OVERRIDEN METHODS                              */
 /*----------------------------------------------------------------------------*/
 
-model::Symbol DiscreteConverter::convert(const option::Symbol &orig) const {
+model::Symbol DiscreteConverter::convert(const std::string &orig) const {
   return out_to_in_.at(orig);
 }
 
 /*----------------------------------------------------------------------------*/
 
-option::Symbol DiscreteConverter::convert(const model::Symbol &orig) const {
+std::string DiscreteConverter::convert(const model::Symbol &orig) const {
   return in_to_out_.at(orig);
 }
 
@@ -21,36 +21,125 @@
 #include "config/Domain.hpp"
 
 // Standard headers
+#include <mutex>
 #include <memory>
+#include <string>
 #include <utility>
+#include <unordered_map>
 
 // Internal headers
+#include "config/Arena.hpp"
 #include "config/BasicConfig.hpp"
+#include "config/RangeConverter.hpp"
 #include "config/CustomConverter.hpp"
 #include "config/DiscreteConverter.hpp"
 
 namespace config {
 
+/*----------------------------------------------------------------------------*/
+/*                               LOCAL STRUCTS                                */
+/*----------------------------------------------------------------------------*/
+
+struct DiscreteDomainRegistry {
+  struct Entry {
+    std::weak_ptr<Converter> converter;
+    std::weak_ptr<Domain::Data> data;
+  };
+
+  std::mutex mutex;
+  std::unordered_map<std::string, Entry> entries;
+  std::size_t next_sweep = 64;  // Size in which expired entries are erased
+};
+
+/*----------------------------------------------------------------------------*/
+/*                               LOCAL FUNCTIONS                              */
+/*----------------------------------------------------------------------------*/
+
+static DiscreteDomainRegistry &discreteDomainRegistry() {
+  static DiscreteDomainRegistry registry;
+  return registry;
+}
+
+/*----------------------------------------------------------------------------*/
+
+static std::string registryKey(const option::Alphabet &alphabet) {
+  // Sizes keep symbols containing separators from colliding
+  std::string key;
+  for (const auto &symbol : alphabet) {
+    const auto &name = symbol.str();
+    key.append(std::to_string(name.size())).append(":").append(name);
+  }
+  return key;
+}
+
 /*----------------------------------------------------------------------------*/
 /*                                CONSTRUCTORS                                */
 /*----------------------------------------------------------------------------*/
 
-Domain::Domain(discrete_domain, option::Alphabet alphabet)
-    : converter_(std::make_shared<DiscreteConverter>(alphabet)) {
+Domain::Domain(discrete_domain, option::Alphabet alphabet) {
+  auto &registry = discreteDomainRegistry();
+  auto key = registryKey(alphabet);
+
+  std::lock_guard<std::mutex> lock(registry.mutex);
+
+  auto &entry = registry.entries[key];
+  converter_ = entry.converter.lock();
+  data_ = entry.data.lock();
+  if (converter_ && data_) return;
+
+  // Shared by models of many loads, so kept out of their arenas
+  converter_ = std::make_shared<DiscreteConverter>(alphabet);
   auto data = std::make_shared<DiscreteDomainData>("", "discrete_domain");
   std::get<decltype("alphabet"_t)>(*data) = std::move(alphabet);
   data_ = data;
+
+  entry = { converter_, data_ };
+
+  if (registry.entries.size() >= registry.next_sweep) {
+    for (auto it = registry.entries.begin(); it != registry.entries.end(); ) {
+      if (it->second.converter.expired()) it = registry.entries.erase(it);
+      else ++it;
+    }
+    registry.next_sweep = 2 * registry.entries.size() + 64;
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+
+Domain::Domain(range_domain, option::Size min, option::Size max)
+    : converter_(makeShared<RangeConverter>(min, max)) {
+  auto data = makeShared<RangeDomainData>("", "range_domain");
+  std::get<decltype("min"_t)>(*data) = min;
+  std::get<decltype("max"_t)>(*data) = max;
+  data_ = data;
 }
 
 /*----------------------------------------------------------------------------*/
 
 Domain::Domain(custom_domain, option::OutToInSymbolFunction out_to_in,
                               option::InToOutSymbolFunction in_to_out)
-    : converter_(std::make_shared<CustomConverter>(out_to_in, in_to_out)) {
-  auto data = std::make_shared<CustomDomainData>("", "custom_domain");
-  std::get<decltype("out_to_in"_t)>(*data) = std::move(out_to_in);
-  std::get<decltype("in_to_out"_t)>(*data) = std::move(in_to_out);
-  data_ = data;
+    : converter_(makeShared<CustomConverter>(out_to_in, in_to_out)) {
+  setCustomData(std::move(out_to_in), std::move(in_to_out));
+}
+
+/*----------------------------------------------------------------------------*/
+
+Domain::Domain(custom_domain, option::OutToInSymbolFunction out_to_in,
+                              option::InToOutSymbolFunction in_to_out,
+                              const option::Alphabet &alphabet)
+    : converter_(makeShared<CustomConverter>(out_to_in, in_to_out,
+                                             alphabet)) {
+  setCustomData(std::move(out_to_in), std::move(in_to_out));
+}
+
+/*----------------------------------------------------------------------------*/
+
+Domain::Domain(custom_domain, option::OutToInSymbolFunction out_to_in,
+                              option::InToOutSymbolFunction in_to_out,
+                              std::size_t max_cached)
+    : converter_(makeShared<CustomConverter>(out_to_in, in_to_out,
+                                             max_cached)) {
+  setCustomData(std::move(out_to_in), std::move(in_to_out));
 }
 
 /*----------------------------------------------------------------------------*/
@@ -69,4 +158,26 @@ std::shared_ptr<typename Domain::Data> Domain::data() {
 
 /*----------------------------------------------------------------------------*/
 
+bool Domain::operator==(const Domain &rhs) const {
+  return converter_ == rhs.converter_ && data_ == rhs.data_;
+}
+
+/*----------------------------------------------------------------------------*/
+
+bool Domain::operator!=(const Domain &rhs) const {
+  return !(*this == rhs);
+}
+
+/*----------------------------------------------------------------------------*/
+
+void Domain::setCustomData(option::OutToInSymbolFunction out_to_in,
+                           option::InToOutSymbolFunction in_to_out) {
+  auto data = makeShared<CustomDomainData>("", "custom_domain");
+  std::get<decltype("out_to_in"_t)>(*data) = std::move(out_to_in);
+  std::get<decltype("in_to_out"_t)>(*data) = std::move(in_to_out);
+  data_ = data;
+}
+
+/*----------------------------------------------------------------------------*/
+
 }  // namespace config
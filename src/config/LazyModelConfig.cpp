@@ -0,0 +1,97 @@
+/***********************************************************************/
+/*  Copyright 2016 ToPS                                                */
+/*                                                                     */
+/*  This program is free software; you can redistribute it and/or      */
+/*  modify it under the terms of the GNU  General Public License as    */
+/*  published by the Free Software Foundation; either version 3 of     */
+/*  the License, or (at your option) any later version.                */
+/*                                                                     */
+/*  This program is distributed in the hope that it will be useful,    */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of     */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the      */
+/*  GNU General Public License for more details.                       */
+/*                                                                     */
+/*  You should have received a copy of the GNU General Public License  */
+/*  along with this program; if not, write to the Free Software        */
+/*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,         */
+/*  MA 02110-1301, USA.                                                */
+/***********************************************************************/
+
+// Interface header
+#include "config/LazyModelConfig.hpp"
+
+// Standard headers
+#include <mutex>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace config {
+
+/*----------------------------------------------------------------------------*/
+/*                                CONSTRUCTORS                                */
+/*----------------------------------------------------------------------------*/
+
+LazyModelConfig::LazyModelConfig(const std::string &path, Loader loader)
+    : ModelConfig(path), loader_(std::move(loader)), loaded_(false) {
+}
+
+/*----------------------------------------------------------------------------*/
+/*                               STATIC METHODS                               */
+/*----------------------------------------------------------------------------*/
+
+std::shared_ptr<LazyModelConfig>
+LazyModelConfig::make(const std::string &path, Loader loader) {
+  return std::make_shared<LazyModelConfig>(path, std::move(loader));
+}
+
+/*----------------------------------------------------------------------------*/
+
+ModelConfigPtr LazyModelConfig::resolve(ModelConfigPtr model_ptr) {
+  auto lazy_ptr = std::dynamic_pointer_cast<LazyModelConfig>(model_ptr);
+  return lazy_ptr ? lazy_ptr->model() : model_ptr;
+}
+
+/*----------------------------------------------------------------------------*/
+/*                             OVERRIDEN METHODS                              */
+/*----------------------------------------------------------------------------*/
+
+void LazyModelConfig::accept(ModelConfigVisitor &visitor) const {
+  model()->accept(visitor);
+}
+
+/*----------------------------------------------------------------------------*/
+
+void LazyModelConfig::accept(ModelConfigVisitor &&visitor) const {
+  model()->accept(visitor);
+}
+
+/*----------------------------------------------------------------------------*/
+
+std::size_t LazyModelConfig::number_of_options() const {
+  return model()->number_of_options();
+}
+
+/*----------------------------------------------------------------------------*/
+/*                              CONCRETE METHODS                              */
+/*----------------------------------------------------------------------------*/
+
+ModelConfigPtr LazyModelConfig::model() const {
+  std::call_once(once_, [this] {
+    // Proxies of proxies are collapsed, so that visitors see a real model
+    model_ = resolve(loader_());
+    loaded_ = true;
+  });
+
+  return model_;
+}
+
+/*----------------------------------------------------------------------------*/
+
+bool LazyModelConfig::loaded() const {
+  return loaded_;
+}
+
+/*----------------------------------------------------------------------------*/
+
+}  // namespace config
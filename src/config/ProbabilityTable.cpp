@@ -0,0 +1,224 @@
+/***********************************************************************/
+/*  Copyright 2016 ToPS                                                */
+/*                                                                     */
+/*  This program is free software; you can redistribute it and/or      */
+/*  modify it under the terms of the GNU  General Public License as    */
+/*  published by the Free Software Foundation; either version 3 of     */
+/*  the License, or (at your option) any later version.                */
+/*                                                                     */
+/*  This program is distributed in the hope that it will be useful,    */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of     */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the      */
+/*  GNU General Public License for more details.                       */
+/*                                                                     */
+/*  You should have received a copy of the GNU General Public License  */
+/*  along with this program; if not, write to the Free Software        */
+/*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,         */
+/*  MA 02110-1301, USA.                                                */
+/***********************************************************************/
+
+// Interface header
+#include "config/ProbabilityTable.hpp"
+
+// Standard headers
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <iterator>
+#include <stdexcept>
+
+namespace config {
+
+/*----------------------------------------------------------------------------*/
+/*                                CONSTRUCTORS                                */
+/*----------------------------------------------------------------------------*/
+
+ProbabilityTable::ProbabilityTable(std::initializer_list<value_type> entries) {
+  insert(entries.begin(), entries.end());
+}
+
+/*----------------------------------------------------------------------------*/
+/*                              CONCRETE METHODS                              */
+/*----------------------------------------------------------------------------*/
+
+double &ProbabilityTable::operator[](const Condition &key) {
+  return entries_[emplaceKey(key, 0).first].second;
+}
+
+/*----------------------------------------------------------------------------*/
+
+double &ProbabilityTable::operator[](Condition &&key) {
+  return entries_[emplaceKey(std::move(key), 0).first].second;
+}
+
+/*----------------------------------------------------------------------------*/
+
+double &ProbabilityTable::operator[](const std::string &key) {
+  return (*this)[Condition::parse(key)];
+}
+
+/*----------------------------------------------------------------------------*/
+
+double &ProbabilityTable::at(const Condition &key) {
+  auto it = find(key);
+  if (it == end()) throw std::out_of_range("No probability for " + key.str());
+  return entries_[static_cast<std::size_t>(it - begin())].second;
+}
+
+/*----------------------------------------------------------------------------*/
+
+const double &ProbabilityTable::at(const Condition &key) const {
+  auto it = find(key);
+  if (it == end()) throw std::out_of_range("No probability for " + key.str());
+  return it->second;
+}
+
+/*----------------------------------------------------------------------------*/
+
+ProbabilityTable::const_iterator
+ProbabilityTable::find(const Condition &key) const {
+  if (slots_.empty()) return end();
+  auto slot = slots_[findSlot(key)];
+  return slot == 0 ? end() : begin() + (slot - 1);
+}
+
+/*----------------------------------------------------------------------------*/
+
+std::size_t ProbabilityTable::count(const Condition &key) const {
+  return find(key) == end() ? 0 : 1;
+}
+
+/*----------------------------------------------------------------------------*/
+
+// Position of the entry of the key, and whether it was inserted
+template<typename Key>
+std::pair<std::size_t, bool>
+ProbabilityTable::emplaceKey(Key &&key, double value) {
+  // Keeps the load factor of the index at most 1/2
+  if (2 * (entries_.size() + 1) > slots_.size())
+    rehash(slots_.empty() ? 16 : 2 * slots_.size());
+
+  auto &slot = slots_[findSlot(key)];
+  if (slot != 0) return { slot - 1, false };
+
+  entries_.emplace_back(std::forward<Key>(key), value);
+  slot = static_cast<std::uint32_t>(entries_.size());
+  return { entries_.size() - 1, true };
+}
+
+/*----------------------------------------------------------------------------*/
+
+std::pair<ProbabilityTable::iterator, bool>
+ProbabilityTable::emplace(const Condition &key, double value) {
+  auto result = emplaceKey(key, value);
+  return { begin() + result.first, result.second };
+}
+
+/*----------------------------------------------------------------------------*/
+
+std::pair<ProbabilityTable::iterator, bool>
+ProbabilityTable::emplace(Condition &&key, double value) {
+  auto result = emplaceKey(std::move(key), value);
+  return { begin() + result.first, result.second };
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ProbabilityTable::reserve(std::size_t size) {
+  entries_.reserve(size);
+
+  std::size_t number_of_slots = slots_.empty() ? 16 : slots_.size();
+  while (number_of_slots < 2 * size) number_of_slots *= 2;
+  if (number_of_slots > slots_.size()) rehash(number_of_slots);
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ProbabilityTable::clear() {
+  entries_.clear();
+  slots_.clear();
+}
+
+/*----------------------------------------------------------------------------*/
+
+std::size_t ProbabilityTable::size() const {
+  return entries_.size();
+}
+
+/*----------------------------------------------------------------------------*/
+
+bool ProbabilityTable::empty() const {
+  return entries_.empty();
+}
+
+/*----------------------------------------------------------------------------*/
+
+std::size_t ProbabilityTable::capacity() const {
+  return entries_.capacity();
+}
+
+/*----------------------------------------------------------------------------*/
+
+std::size_t ProbabilityTable::bucket_count() const {
+  return slots_.size();
+}
+
+/*----------------------------------------------------------------------------*/
+
+ProbabilityTable::const_iterator ProbabilityTable::begin() const {
+  return entries_.begin();
+}
+
+/*----------------------------------------------------------------------------*/
+
+ProbabilityTable::const_iterator ProbabilityTable::end() const {
+  return entries_.end();
+}
+
+/*----------------------------------------------------------------------------*/
+
+bool ProbabilityTable::operator==(const ProbabilityTable &rhs) const {
+  if (size() != rhs.size()) return false;
+
+  for (const auto &entry : entries_) {
+    auto it = rhs.find(entry.first);
+    if (it == rhs.end() || it->second != entry.second) return false;
+  }
+
+  return true;
+}
+
+/*----------------------------------------------------------------------------*/
+
+bool ProbabilityTable::operator!=(const ProbabilityTable &rhs) const {
+  return !(*this == rhs);
+}
+
+/*----------------------------------------------------------------------------*/
+
+std::size_t ProbabilityTable::findSlot(const Condition &key) const {
+  // Linear probing; the number of slots is always a power of 2
+  auto mask = slots_.size() - 1;
+  for (auto i = key.hash() & mask; ; i = (i + 1) & mask) {
+    if (slots_[i] == 0 || entries_[slots_[i] - 1].first == key) return i;
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ProbabilityTable::rehash(std::size_t number_of_slots) {
+  slots_.assign(number_of_slots, 0);
+
+  auto mask = number_of_slots - 1;
+  for (std::size_t e = 0; e < entries_.size(); e++) {
+    auto i = entries_[e].first.hash() & mask;
+    while (slots_[i] != 0) i = (i + 1) & mask;
+    slots_[i] = static_cast<std::uint32_t>(e + 1);
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+
+}  // namespace config
@@ -0,0 +1,86 @@
+/***********************************************************************/
+/*  Copyright 2016 ToPS                                                */
+/*                                                                     */
+/*  This program is free software; you can redistribute it and/or      */
+/*  modify it under the terms of the GNU  General Public License as    */
+/*  published by the Free Software Foundation; either version 3 of     */
+/*  the License, or (at your option) any later version.                */
+/*                                                                     */
+/*  This program is distributed in the hope that it will be useful,    */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of     */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the      */
+/*  GNU General Public License for more details.                       */
+/*                                                                     */
+/*  You should have received a copy of the GNU General Public License  */
+/*  along with this program; if not, write to the Free Software        */
+/*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,         */
+/*  MA 02110-1301, USA.                                                */
+/***********************************************************************/
+
+// Interface header
+#include "config/RangeConverter.hpp"
+
+// Standard headers
+#include <string>
+#include <cstdint>
+#include <stdexcept>
+
+namespace config {
+
+/*----------------------------------------------------------------------------*/
+/*                               LOCAL CONSTANTS                              */
+/*----------------------------------------------------------------------------*/
+
+// Digits of the largest option::Size, so that parsing cannot overflow
+static const std::size_t max_digits = 10;
+
+/*----------------------------------------------------------------------------*/
+/*                               LOCAL FUNCTIONS                              */
+/*----------------------------------------------------------------------------*/
+
+[[noreturn]] static void outOfRange(const std::string &symbol) {
+  throw std::out_of_range("Symbol " + symbol + " out of range domain");
+}
+
+/*----------------------------------------------------------------------------*/
+/*                                CONSTRUCTORS                                */
+/*----------------------------------------------------------------------------*/
+
+RangeConverter::RangeConverter(option::Size min, option::Size max)
+    : min_(min), max_(max) {
+  if (min > max)
+    throw std::invalid_argument("Empty range domain: "
+                                + std::to_string(min) + " > "
+                                + std::to_string(max));
+}
+
+/*----------------------------------------------------------------------------*/
+/*                             OVERRIDEN METHODS                              */
+/*----------------------------------------------------------------------------*/
+
+model::Symbol RangeConverter::convert(const std::string &orig) const {
+  if (orig.empty() || orig.size() > max_digits) outOfRange(orig);
+
+  // Non-digits are accumulated in a flag, checked once after the loop
+  std::uint64_t value = 0;
+  unsigned int invalid = 0;
+  for (char c : orig) {
+    unsigned int digit = static_cast<unsigned char>(c) - '0';
+    invalid |= digit > 9;
+    value = 10 * value + digit;
+  }
+
+  if (invalid || value < min_ || value > max_) outOfRange(orig);
+  return static_cast<model::Symbol>(value - min_);
+}
+
+/*----------------------------------------------------------------------------*/
+
+std::string RangeConverter::convert(const model::Symbol &orig) const {
+  if (orig > max_ - min_) outOfRange(std::to_string(orig));
+  return std::to_string(min_ + orig);
+}
+
+/*----------------------------------------------------------------------------*/
+
+}  // namespace config
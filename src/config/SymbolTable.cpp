@@ -0,0 +1,224 @@
+/***********************************************************************/
+/*  Copyright 2016 ToPS                                                */
+/*                                                                     */
+/*  This program is free software; you can redistribute it and/or      */
+/*  modify it under the terms of the GNU  General Public License as    */
+/*  published by the Free Software Foundation; either version 3 of     */
+/*  the License, or (at your option) any later version.                */
+/*                                                                     */
+/*  This program is distributed in the hope that it will be useful,    */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of     */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the      */
+/*  GNU General Public License for more details.                       */
+/*                                                                     */
+/*  You should have received a copy of the GNU General Public License  */
+/*  along with this program; if not, write to the Free Software        */
+/*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,         */
+/*  MA 02110-1301, USA.                                                */
+/***********************************************************************/
+
+// Interface header
+#include "config/SymbolTable.hpp"
+
+// Standard headers
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <cstddef>
+#include <ostream>
+#include <utility>
+#include <functional>
+
+namespace config {
+
+/*----------------------------------------------------------------------------*/
+/*                               LOCAL VARIABLES                              */
+/*----------------------------------------------------------------------------*/
+
+// Table of the innermost scope opened by this thread
+static thread_local SymbolTablePtr current_table;
+
+/*----------------------------------------------------------------------------*/
+/*                               LOCAL FUNCTIONS                              */
+/*----------------------------------------------------------------------------*/
+
+// Used when no scope is open, as by trainers and tests
+static const SymbolTablePtr &defaultTable() {
+  static const SymbolTablePtr table = std::make_shared<SymbolTable>();
+  return table;
+}
+
+/*----------------------------------------------------------------------------*/
+/*                                INNER CLASSES                               */
+/*----------------------------------------------------------------------------*/
+
+SymbolTable::Symbol::Symbol() : entry_(emptyEntry()) {
+}
+
+/*----------------------------------------------------------------------------*/
+
+SymbolTable::Symbol::Symbol(const std::string &name)
+    : Symbol(current()->intern(name)) {
+}
+
+/*----------------------------------------------------------------------------*/
+
+SymbolTable::Symbol::Symbol(const char *name)
+    : Symbol(current()->intern(name, std::char_traits<char>::length(name))) {
+}
+
+/*----------------------------------------------------------------------------*/
+
+SymbolTable::Symbol::Symbol(const Entry *entry) : entry_(entry) {
+}
+
+/*----------------------------------------------------------------------------*/
+
+const std::string &SymbolTable::Symbol::str() const {
+  return entry_->name;
+}
+
+/*----------------------------------------------------------------------------*/
+
+std::size_t SymbolTable::Symbol::hash() const {
+  return entry_->hash;
+}
+
+/*----------------------------------------------------------------------------*/
+
+SymbolTable::Symbol::operator const std::string &() const {
+  return entry_->name;
+}
+
+/*----------------------------------------------------------------------------*/
+
+bool SymbolTable::Symbol::operator==(const Symbol &rhs) const {
+  // Strings are only compared for symbols of different tables
+  return entry_ == rhs.entry_
+      || (entry_->hash == rhs.entry_->hash && entry_->name == rhs.entry_->name);
+}
+
+/*----------------------------------------------------------------------------*/
+
+bool SymbolTable::Symbol::operator!=(const Symbol &rhs) const {
+  return !(*this == rhs);
+}
+
+/*----------------------------------------------------------------------------*/
+
+bool SymbolTable::Symbol::operator<(const Symbol &rhs) const {
+  return entry_ != rhs.entry_ && entry_->name < rhs.entry_->name;
+}
+
+/*----------------------------------------------------------------------------*/
+
+bool SymbolTable::Symbol::operator==(const std::string &rhs) const {
+  return entry_->name == rhs;
+}
+
+/*----------------------------------------------------------------------------*/
+
+bool SymbolTable::Symbol::operator!=(const std::string &rhs) const {
+  return entry_->name != rhs;
+}
+
+/*----------------------------------------------------------------------------*/
+
+bool SymbolTable::Symbol::operator==(const char *rhs) const {
+  return entry_->name == rhs;
+}
+
+/*----------------------------------------------------------------------------*/
+
+bool SymbolTable::Symbol::operator!=(const char *rhs) const {
+  return entry_->name != rhs;
+}
+
+/*----------------------------------------------------------------------------*/
+
+SymbolTable::Scope::Scope(SymbolTablePtr table) : previous_(current_table) {
+  current_table = std::move(table);
+}
+
+/*----------------------------------------------------------------------------*/
+
+SymbolTable::Scope::~Scope() {
+  current_table = std::move(previous_);
+}
+
+/*----------------------------------------------------------------------------*/
+/*                               STATIC METHODS                               */
+/*----------------------------------------------------------------------------*/
+
+const SymbolTablePtr &SymbolTable::current() {
+  return current_table ? current_table : defaultTable();
+}
+
+/*----------------------------------------------------------------------------*/
+
+const SymbolTable::Entry *SymbolTable::emptyEntry() {
+  static const Entry entry { "", std::hash<std::string>()("") };
+  return &entry;
+}
+
+/*----------------------------------------------------------------------------*/
+/*                              CONCRETE METHODS                              */
+/*----------------------------------------------------------------------------*/
+
+SymbolTable::Symbol SymbolTable::intern(const char *name, std::size_t size) {
+  // Alphabets of nucleotides and aminoacids only have one-character names
+  auto character = size == 1 ? &characters_[
+    static_cast<unsigned char>(name[0])] : nullptr;
+  if (character) {
+    auto entry = character->load(std::memory_order_acquire);
+    if (entry) return Symbol(entry);
+  }
+
+  Entry key { std::string(name, size), 0 };
+  key.hash = std::hash<std::string>()(key.name);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  // Elements of unordered sets keep their addresses when rehashing
+  auto entry = &*entries_.insert(std::move(key)).first;
+  if (character) character->store(entry, std::memory_order_release);
+  return Symbol(entry);
+}
+
+/*----------------------------------------------------------------------------*/
+
+SymbolTable::Symbol SymbolTable::intern(const std::string &name) {
+  return intern(name.data(), name.size());
+}
+
+/*----------------------------------------------------------------------------*/
+
+std::size_t SymbolTable::size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return entries_.size();
+}
+
+/*----------------------------------------------------------------------------*/
+/*                                 OPERATORS                                  */
+/*----------------------------------------------------------------------------*/
+
+bool operator==(const std::string &lhs, const SymbolTable::Symbol &rhs) {
+  return rhs == lhs;
+}
+
+/*----------------------------------------------------------------------------*/
+
+bool operator!=(const std::string &lhs, const SymbolTable::Symbol &rhs) {
+  return rhs != lhs;
+}
+
+/*----------------------------------------------------------------------------*/
+
+std::ostream &operator<<(std::ostream &os, const SymbolTable::Symbol &symbol) {
+  return os << symbol.str();
+}
+
+/*----------------------------------------------------------------------------*/
+
+}  // namespace config
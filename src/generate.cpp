@@ -0,0 +1,637 @@
+/***********************************************************************/
+/*  Copyright 2016 ToPS                                                */
+/*                                                                     */
+/*  This program is free software; you can redistribute it and/or      */
+/*  modify it under the terms of the GNU  General Public License as    */
+/*  published by the Free Software Foundation; either version 3 of     */
+/*  the License, or (at your option) any later version.                */
+/*                                                                     */
+/*  This program is distributed in the hope that it will be useful,    */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of     */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the      */
+/*  GNU General Public License for more details.                       */
+/*                                                                     */
+/*  You should have received a copy of the GNU General Public License  */
+/*  along with this program; if not, write to the Free Software        */
+/*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,         */
+/*  MA 02110-1301, USA.                                                */
+/***********************************************************************/
+
+// Standard headers
+#include <set>
+#include <cmath>
+#include <cerrno>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <utility>
+#include <iostream>
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+
+// Internal headers
+#include "filesystem/Filesystem.hpp"
+
+/*
+\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\
+ -------------------------------------------------------------------------------
+                                    RANDOM
+ -------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
+*/
+
+// Distributions of <random> are implementation-defined, so only the engine
+// (fully specified by the standard) is used: the same seed generates the
+// same files with any standard library.
+using Engine = std::mt19937_64;
+
+/*----------------------------------------------------------------------------*/
+
+static double uniform(Engine &engine) {
+  // 53 random bits, as many as the mantissa of a double
+  return static_cast<double>(engine() >> 11) / 9007199254740992.0;
+}
+
+/*----------------------------------------------------------------------------*/
+
+static std::size_t uniformIndex(Engine &engine, std::size_t size) {
+  return static_cast<std::size_t>(uniform(engine) * static_cast<double>(size));
+}
+
+/*----------------------------------------------------------------------------*/
+
+// Random distribution without probabilities too close to zero
+static std::vector<double> makeDistribution(Engine &engine, std::size_t size) {
+  std::vector<double> distribution(size);
+
+  double total = 0;
+  for (auto &probability : distribution)
+    total += probability = 0.1 + uniform(engine);
+  for (auto &probability : distribution)
+    probability /= total;
+
+  return distribution;
+}
+
+/*----------------------------------------------------------------------------*/
+
+static std::size_t sample(Engine &engine,
+                          const std::vector<double> &distribution) {
+  double value = uniform(engine);
+  for (std::size_t i = 0; i + 1 < distribution.size(); i++) {
+    if (value < distribution[i]) return i;
+    value -= distribution[i];
+  }
+  return distribution.size() - 1;
+}
+
+/*
+\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\
+ -------------------------------------------------------------------------------
+                                    WRITING
+ -------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
+*/
+
+static const std::vector<std::string> nucleotides { "A", "C", "G", "T" };
+
+/*----------------------------------------------------------------------------*/
+
+struct Options {
+  std::string output_dir;
+  std::uint64_t seed = 42;
+
+  std::size_t order = 2;     // VLMC
+  std::size_t states = 4;    // GHMM
+  std::size_t nesting = 1;   // GHMM
+  std::size_t phases = 3;    // IMC and GHMM
+  std::size_t depth = 3;     // MDD
+  std::size_t kmers = 100;   // SBSW
+  std::size_t k = 9;         // SBSW
+  std::size_t length = 0;    // Dataset sampled from the GHMM
+
+  bool tables = false;       // Probabilities in TSV files loaded by table()
+};
+
+/*----------------------------------------------------------------------------*/
+
+static std::ofstream openFile(const Options &options, const std::string &file) {
+  std::ofstream dst(options.output_dir + file);
+  if (!dst) throw std::runtime_error("Could not write " + file);
+
+  dst << "// -*- mode: c++ -*-\n"
+      << "// vim: ft=chaiscript:\n"
+      << "\n";
+  return dst;
+}
+
+/*----------------------------------------------------------------------------*/
+
+static std::string number(double value) {
+  char buffer[32];
+  std::snprintf(buffer, sizeof(buffer), "%.17g", value);
+  return buffer;
+}
+
+/*----------------------------------------------------------------------------*/
+
+static std::string quoted(const std::string &string) {
+  return '"' + string + '"';
+}
+
+/*----------------------------------------------------------------------------*/
+
+static void writeObservations(std::ostream &dst) {
+  dst << "observations = [ \"A\", \"C\", \"G\", \"T\" ]\n\n";
+}
+
+/*----------------------------------------------------------------------------*/
+
+// Entries are `target | context` keys with their probabilities. Big tables
+// go to a TSV file next to the model when options.tables is set.
+struct Table {
+  std::vector<std::pair<std::string, std::string>> keys;
+  std::vector<double> values;
+};
+
+static void writeTable(const Options &options, std::ostream &dst,
+                       const std::string &file, const std::string &tag,
+                       const Table &table) {
+  dst << tag << " = ";
+
+  if (options.tables) {
+    auto table_file = file.substr(0, file.rfind('.')) + "." + tag + ".tsv";
+    std::ofstream tsv(options.output_dir + table_file);
+    for (std::size_t i = 0; i < table.values.size(); i++)
+      tsv << table.keys[i].first << " | " << table.keys[i].second
+          << '\t' << number(table.values[i]) << '\n';
+    dst << "table(" << quoted(table_file.substr(table_file.rfind('/') + 1))
+        << ")\n\n";
+    return;
+  }
+
+  dst << "[\n";
+  for (std::size_t i = 0; i < table.values.size(); i++) {
+    dst << "  " << quoted(table.keys[i].first)
+        << " | " << quoted(table.keys[i].second)
+        << " : " << number(table.values[i])
+        << (i + 1 < table.values.size() ? ",\n" : "\n");
+  }
+  dst << "]\n\n";
+}
+
+/*
+\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\
+ -------------------------------------------------------------------------------
+                                    MODELS
+ -------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
+*/
+
+/*----------------------------------------------------------------------------*/
+/*                                    VLMC                                    */
+/*----------------------------------------------------------------------------*/
+
+// Distributions for every context of length 0 to `order`, indexed by the
+// length and then by the context read as a number in base 4 (oldest symbol
+// as the most significant digit).
+struct VLMC {
+  std::size_t order;
+  std::vector<std::vector<std::vector<double>>> distributions;
+
+  std::size_t emit(Engine &engine, const std::vector<std::size_t> &sequence,
+                   std::size_t segment_begin) const {
+    auto length = std::min(order, sequence.size() - segment_begin);
+
+    std::size_t context = 0;
+    for (auto i = sequence.size() - length; i < sequence.size(); i++)
+      context = 4 * context + sequence[i];
+
+    return sample(engine, distributions[length][context]);
+  }
+};
+
+/*----------------------------------------------------------------------------*/
+
+static std::string contextName(std::size_t context, std::size_t length) {
+  std::string name;
+  for (std::size_t i = 0; i < length; i++) {
+    name.insert(0, nucleotides[context % 4]);
+    if (i + 1 < length) name.insert(0, " ");
+    context /= 4;
+  }
+  return name;
+}
+
+/*----------------------------------------------------------------------------*/
+
+static VLMC generateVLMC(const Options &options, Engine &engine,
+                         const std::string &file) {
+  VLMC vlmc { options.order, {} };
+
+  Table table;
+  for (std::size_t length = 0, contexts = 1; length <= options.order;
+       length++, contexts *= 4) {
+    vlmc.distributions.emplace_back();
+    for (std::size_t context = 0; context < contexts; context++) {
+      vlmc.distributions.back().push_back(makeDistribution(engine, 4));
+      for (std::size_t symbol = 0; symbol < 4; symbol++) {
+        table.keys.emplace_back(nucleotides[symbol],
+                                contextName(context, length));
+        table.values.push_back(vlmc.distributions.back().back()[symbol]);
+      }
+    }
+  }
+
+  auto dst = openFile(options, file);
+  dst << "model_type = \"VLMC\"\n\n";
+  writeObservations(dst);
+  writeTable(options, dst, file, "context_probabilities", table);
+
+  return vlmc;
+}
+
+/*----------------------------------------------------------------------------*/
+/*                                    IMC                                     */
+/*----------------------------------------------------------------------------*/
+
+static void writeIMC(const Options &options, const std::string &file,
+                     const std::string &type,
+                     const std::vector<std::string> &phases) {
+  auto dst = openFile(options, file);
+  dst << "model_type = " << quoted(type) << "\n\n";
+  writeObservations(dst);
+
+  dst << "position_specific_distributions = [\n";
+  for (std::size_t i = 0; i < phases.size(); i++)
+    dst << "  model(" << quoted(phases[i]) << ")"
+        << (i + 1 < phases.size() ? ",\n" : "\n");
+  dst << "]\n";
+}
+
+/*----------------------------------------------------------------------------*/
+
+static void generateIMC(const Options &options, Engine &engine) {
+  std::vector<std::string> phases;
+  for (std::size_t p = 0; p < options.phases; p++) {
+    phases.push_back("imc_phase_" + std::to_string(p) + ".tops");
+    generateVLMC(options, engine, phases.back());
+  }
+  writeIMC(options, "imc.tops", "IMC", phases);
+}
+
+/*----------------------------------------------------------------------------*/
+/*                                    GHMM                                    */
+/*----------------------------------------------------------------------------*/
+
+struct GHMM {
+  std::vector<std::string> labels;
+  std::vector<VLMC> emissions;
+  std::vector<double> initial;
+  std::vector<std::vector<double>> transitions;  // By source state
+};
+
+/*----------------------------------------------------------------------------*/
+
+// Each emission is nested `nesting` times inside periodic IMCs, whose
+// phases all refer to the next level. The innermost level is a VLMC, so
+// the nesting does not change the distribution of emitted symbols.
+static VLMC generateEmission(const Options &options, Engine &engine,
+                             const std::string &state) {
+  for (std::size_t level = 0; level < options.nesting; level++) {
+    auto next = state + "_level_" + std::to_string(level + 1) + ".tops";
+    writeIMC(options, state + "_level_" + std::to_string(level) + ".tops",
+             "PeriodicIMC", std::vector<std::string>(options.phases, next));
+  }
+  return generateVLMC(options, engine, state + "_level_"
+                                     + std::to_string(options.nesting)
+                                     + ".tops");
+}
+
+/*----------------------------------------------------------------------------*/
+
+static GHMM generateGHMM(const Options &options, Engine &engine) {
+  GHMM ghmm;
+
+  for (std::size_t s = 0; s < options.states; s++) {
+    ghmm.labels.push_back("S" + std::to_string(s));
+    ghmm.emissions.push_back(generateEmission(options, engine,
+                                              ghmm.labels.back()));
+  }
+
+  ghmm.initial = makeDistribution(engine, options.states);
+
+  // Long segments: most of the mass stays in the same state
+  for (std::size_t s = 0; s < options.states; s++) {
+    auto others = makeDistribution(engine, options.states);
+    double stay = options.states == 1 ? 1 : 0.9 + 0.09 * uniform(engine);
+    others[s] = 0;
+
+    double total = 0;
+    for (auto probability : others) total += probability;
+    for (auto &probability : others)
+      probability *= (1 - stay) / (total > 0 ? total : 1);
+    others[s] = stay;
+
+    ghmm.transitions.push_back(others);
+  }
+
+  auto dst = openFile(options, "ghmm.tops");
+  dst << "model_type = \"GHMM\"\n\n";
+  writeObservations(dst);
+
+  dst << "labels = [ ";
+  for (std::size_t s = 0; s < options.states; s++)
+    dst << quoted(ghmm.labels[s]) << (s + 1 < options.states ? ", " : " ");
+  dst << "]\n\n";
+
+  dst << "states = [\n";
+  for (std::size_t s = 0; s < options.states; s++)
+    dst << "  " << quoted(ghmm.labels[s]) << " : [ duration: geometric(),\n"
+        << "    emission: model("
+        << quoted(ghmm.labels[s] + "_level_0.tops") << ") ]"
+        << (s + 1 < options.states ? ",\n" : "\n");
+  dst << "]\n\n";
+
+  dst << "initial_probabilities = [\n";
+  for (std::size_t s = 0; s < options.states; s++)
+    dst << "  " << quoted(ghmm.labels[s]) << " : " << number(ghmm.initial[s])
+        << (s + 1 < options.states ? ",\n" : "\n");
+  dst << "]\n\n";
+
+  Table transitions;
+  for (std::size_t from = 0; from < options.states; from++) {
+    for (std::size_t to = 0; to < options.states; to++) {
+      transitions.keys.emplace_back(ghmm.labels[to], ghmm.labels[from]);
+      transitions.values.push_back(ghmm.transitions[from][to]);
+    }
+  }
+  writeTable(options, dst, "ghmm.tops", "transition_probabilities",
+             transitions);
+
+  return ghmm;
+}
+
+/*----------------------------------------------------------------------------*/
+
+// Labeled sequence sampled from the GHMM, both in the TSV format read by
+// the `lang` binary (one symbol per line) and in FASTA. The segments of
+// each state are also listed in their own TSV file.
+static void sampleDataset(const Options &options, Engine &engine,
+                          const GHMM &ghmm) {
+  std::ofstream tsv(options.output_dir + "dataset.tsv");
+  std::ofstream fasta(options.output_dir + "dataset.fasta");
+  std::ofstream segments(options.output_dir + "dataset.segments.tsv");
+
+  tsv << "sequence\tlabel\n";
+  fasta << ">sequence length=" << options.length << "\n";
+  segments << "label\tbegin\tend\n";
+
+  std::vector<std::size_t> sequence;
+  sequence.reserve(options.length);
+
+  std::size_t state = sample(engine, ghmm.initial);
+  std::size_t segment_begin = 0;
+
+  for (std::size_t i = 0; i < options.length; i++) {
+    if (i > 0) {
+      auto next = sample(engine, ghmm.transitions[state]);
+      if (next != state) {
+        segments << ghmm.labels[state] << '\t' << segment_begin
+                 << '\t' << i << '\n';
+        segment_begin = i;
+      }
+      state = next;
+    }
+
+    sequence.push_back(ghmm.emissions[state].emit(engine, sequence,
+                                                  segment_begin));
+
+    const auto &symbol = nucleotides[sequence.back()];
+    tsv << symbol << '\t' << ghmm.labels[state] << '\n';
+    fasta << symbol << ((i + 1) % 60 == 0 ? "\n" : "");
+  }
+
+  if (options.length > 0) {
+    segments << ghmm.labels[state] << '\t' << segment_begin
+             << '\t' << options.length << '\n';
+  }
+  if (options.length % 60 != 0) fasta << '\n';
+}
+
+/*----------------------------------------------------------------------------*/
+/*                                    MDD                                     */
+/*----------------------------------------------------------------------------*/
+
+// As built by maximal dependence decomposition, each split keeps splitting
+// the sequences matching the consensus (first child) while the others go
+// to a leaf (last child). Each node has its own IID model.
+static void writeMDDNode(const Options &options, Engine &engine,
+                         std::ostream &tree, const std::vector<int> &positions,
+                         std::string prefix, bool last, bool leaf,
+                         std::size_t depth, std::size_t &nodes) {
+  auto file = "mdd_node_" + std::to_string(nodes++) + ".tops";
+
+  auto dst = openFile(options, file);
+  dst << "model_type = \"IID\"\n\n";
+  writeObservations(dst);
+
+  auto distribution = makeDistribution(engine, 4);
+  dst << "emission_probabilities = [\n";
+  for (std::size_t symbol = 0; symbol < 4; symbol++)
+    dst << "  " << quoted(nucleotides[symbol]) << " : "
+        << number(distribution[symbol]) << (symbol < 3 ? ",\n" : "\n");
+  dst << "]\n";
+
+  if (depth > 0) tree << prefix << (last ? " `- " : " |- ");
+  tree << "(" << (leaf ? "*" : std::to_string(positions[depth])) << ") "
+       << "model(" << quoted(file) << ")\n";
+
+  if (leaf) return;
+
+  if (depth > 0) prefix += last ? "    " : " |  ";
+  writeMDDNode(options, engine, tree, positions, prefix, false,
+               depth + 1 == options.depth, depth + 1, nodes);
+  writeMDDNode(options, engine, tree, positions, prefix, true,
+               true, depth + 1, nodes);
+}
+
+/*----------------------------------------------------------------------------*/
+
+static void generateMDD(const Options &options, Engine &engine) {
+  // Positions of the consensus tested at each depth, all different
+  std::size_t length = std::max<std::size_t>(options.depth, 9);
+  std::vector<int> positions(length);
+  for (std::size_t i = 0; i < length; i++) positions[i] = static_cast<int>(i);
+  for (std::size_t i = length - 1; i > 0; i--)
+    std::swap(positions[i], positions[uniformIndex(engine, i + 1)]);
+
+  std::string consensus;
+  for (std::size_t i = 0; i < length; i++) {
+    auto first = uniformIndex(engine, 4);
+    auto second = uniformIndex(engine, 4);
+    if (first == second) {
+      consensus += nucleotides[first];
+    } else {
+      consensus += "[" + nucleotides[std::min(first, second)]
+                       + nucleotides[std::max(first, second)] + "]";
+    }
+  }
+
+  std::ofstream tree(options.output_dir + "mdd.tree");
+  std::size_t nodes = 0;
+  writeMDDNode(options, engine, tree, positions, "", true,
+               options.depth == 0, 0, nodes);
+
+  auto dst = openFile(options, "mdd.tops");
+  dst << "model_type = \"MDD\"\n\n";
+  writeObservations(dst);
+  dst << "consensus = " << quoted(consensus) << "\n\n";
+  dst << "dependencies = [ tree(\"mdd.tree\") ]\n";
+}
+
+/*----------------------------------------------------------------------------*/
+/*                                    SBSW                                    */
+/*----------------------------------------------------------------------------*/
+
+// Distinct k-mers, all containing the skipped sequence at its offset
+static void generateSBSW(const Options &options, Engine &engine) {
+  const std::string skip_sequence = "GT";
+  std::size_t skip_offset = options.k / 3;
+
+  if (options.k < skip_offset + skip_sequence.size())
+    throw std::invalid_argument("k-mers too short for the skip sequence");
+
+  double free_positions = static_cast<double>(options.k - skip_sequence.size());
+  if (static_cast<double>(options.kmers) > std::pow(4.0, free_positions))
+    throw std::invalid_argument("Not enough distinct k-mers");
+
+  std::set<std::string> kmers;
+  while (kmers.size() < options.kmers) {
+    std::string kmer;
+    for (std::size_t i = 0; i < options.k; i++)
+      kmer += nucleotides[uniformIndex(engine, 4)];
+    kmer.replace(skip_offset, skip_sequence.size(), skip_sequence);
+    kmers.insert(kmer);
+  }
+
+  auto dst = openFile(options, "sbsw.tops");
+  dst << "model_type = \"SBSW\"\n\n";
+  writeObservations(dst);
+
+  double normalizer = 0;
+  dst << "sequences = [\n";
+  std::size_t i = 0;
+  for (const auto &kmer : kmers) {
+    double count = static_cast<double>(1 + uniformIndex(engine, 100));
+    normalizer += count;
+    dst << "  " << quoted(kmer) << " : " << number(count)
+        << (++i < kmers.size() ? ",\n" : "\n");
+  }
+  dst << "]\n\n";
+
+  dst << "normalizer = " << number(normalizer) << "\n\n"
+      << "skip_offset = " << skip_offset << "\n\n"
+      << "skip_length = " << skip_sequence.size() << "\n\n"
+      << "skip_sequence = " << quoted(skip_sequence) << "\n";
+}
+
+/*
+\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\
+ -------------------------------------------------------------------------------
+                                      MAIN
+ -------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
+*/
+
+static int usage(const char *program) {
+  std::cerr << "USAGE: " << program << " (vlmc|imc|ghmm|mdd|sbsw)"
+            << " [--seed n] [--order k] [--states n] [--nesting n]"
+            << " [--phases n] [--depth n] [--kmers n] [--k n]"
+            << " [--length n] [--tables] output_dir" << std::endl;
+  return EXIT_FAILURE;
+}
+
+/*----------------------------------------------------------------------------*/
+
+static bool parseCount(const char *text, std::uint64_t &value) {
+  if (*text < '0' || *text > '9') return false;
+
+  char *end = nullptr;
+  errno = 0;
+  value = std::strtoull(text, &end, 10);
+  return errno == 0 && *end == '\0';
+}
+
+/*----------------------------------------------------------------------------*/
+
+int main(int argc, char **argv) try {
+  if (argc < 3) return usage(argv[0]);
+
+  std::string kind = argv[1];
+  Options options;
+
+  for (int i = 2; i < argc; i++) {
+    std::string arg = argv[i];
+
+    if (arg == "--tables") {
+      options.tables = true;
+      continue;
+    }
+
+    if (arg.compare(0, 2, "--") != 0) {
+      options.output_dir = arg;
+      continue;
+    }
+
+    std::uint64_t value = 0;
+    if (i + 1 >= argc || !parseCount(argv[++i], value)) return usage(argv[0]);
+
+    if (arg == "--seed")         options.seed = value;
+    else if (arg == "--order")   options.order = value;
+    else if (arg == "--states")  options.states = value;
+    else if (arg == "--nesting") options.nesting = value;
+    else if (arg == "--phases")  options.phases = value;
+    else if (arg == "--depth")   options.depth = value;
+    else if (arg == "--kmers")   options.kmers = value;
+    else if (arg == "--k")       options.k = value;
+    else if (arg == "--length")  options.length = value;
+    else
+      return usage(argv[0]);
+  }
+
+  if (options.output_dir.empty()) return usage(argv[0]);
+
+  // The GHMM needs a state to start from and an IMC needs a phase
+  if (options.states == 0 || options.phases == 0) return usage(argv[0]);
+  if (options.output_dir.back() != '/') options.output_dir += '/';
+  filesystem::create_directories(options.output_dir);
+
+  Engine engine(options.seed);
+
+  if (kind == "vlmc") {
+    generateVLMC(options, engine, "vlmc.tops");
+  } else if (kind == "imc") {
+    generateIMC(options, engine);
+  } else if (kind == "ghmm") {
+    auto ghmm = generateGHMM(options, engine);
+    if (options.length > 0) sampleDataset(options, engine, ghmm);
+  } else if (kind == "mdd") {
+    generateMDD(options, engine);
+  } else if (kind == "sbsw") {
+    generateSBSW(options, engine);
+  } else {
+    return usage(argv[0]);
+  }
+
+  return EXIT_SUCCESS;
+}
+catch(std::exception &e) {
+  std::cerr << e.what() << std::endl;
+  return EXIT_FAILURE;
+}
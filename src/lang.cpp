@@ -18,11 +18,21 @@
 /***********************************************************************/
 
 // Standard headers
+#include <map>
+#include <set>
+#include <mutex>
+#include <chrono>
 #include <string>
 #include <memory>
+#include <thread>
+#include <vector>
+#include <cstdio>
 #include <cstdlib>
+#include <fstream>
+#include <sstream>
 #include <iostream>
 #include <exception>
+#include <stdexcept>
 
 // Internal headers
 #include "config/BasicConfig.hpp"
@@ -31,90 +41,428 @@
 #include "config/StringLiteralSuffix.hpp"
 #include "config/DecodableModelConfig.hpp"
 
+#include "lang/Util.hpp"
+#include "lang/Tracer.hpp"
 #include "lang/Interpreter.hpp"
+#include "lang/DependencyScanner.hpp"
+#include "lang/MultipleFilePrinter.hpp"
+#include "lang/ModelConfigProfiler.hpp"
 #include "lang/ModelConfigSerializer.hpp"
 
+#include "concurrency/ThreadPool.hpp"
+
 // External headers
 #include "chaiscript/language/chaiscript_common.hpp"
 
+// POSIX headers
+#include <stdlib.h>  // mkstemp
+#include <unistd.h>  // close
+
 // Using declarations
 using config::operator ""_t;
 
 /*
 \\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\
  -------------------------------------------------------------------------------
-                                      MAIN
+                                   CONVERTER
  -------------------------------------------------------------------------------
 ////////////////////////////////////////////////////////////////////////////////
 */
 
-int main(int argc, char **argv) try {
-  if (argc <= 1 || argc >= 5) {
-    std::cerr << "USAGE: " << argv[0] << " model_config [dataset] [output_dir]"
-              << std::endl;
-    return EXIT_FAILURE;
-  }
+static void convertDataset(config::ModelConfigPtr model_cfg,
+                           const std::string &dataset_path,
+                           std::ostream &os) {
+  std::vector<config::ConverterPtr> converters {
+    std::get<decltype("observations"_t)>(*model_cfg)->makeConverter() };
 
-  lang::Interpreter interpreter;
-  auto model_cfg = interpreter.evalModel(argv[1]);
+  auto decodable_model_cfg
+    = std::dynamic_pointer_cast<config::DecodableModelConfig>(model_cfg);
 
-  /*--------------------------------------------------------------------------*/
-  /*                                CONVERTER                                 */
-  /*--------------------------------------------------------------------------*/
+  if (decodable_model_cfg) {
+    auto &domains
+      = std::get<decltype("other_observations"_t)>(*decodable_model_cfg);
+
+    for (auto &domain : domains)
+      converters.push_back(domain->makeConverter());
 
-  if (argc >= 3) {
-    std::vector<config::ConverterPtr> converters {
-      std::get<decltype("observations"_t)>(*model_cfg)->makeConverter() };
+    converters.push_back(
+      std::get<decltype("labels"_t)>(*decodable_model_cfg)->makeConverter());
+  }
 
-    auto decodable_model_cfg
-      = std::dynamic_pointer_cast<config::DecodableModelConfig>(model_cfg);
+  std::fstream dataset(dataset_path);
+  std::string line;
 
-    if (decodable_model_cfg) {
-      auto &domains
-        = std::get<decltype("other_observations"_t)>(*decodable_model_cfg);
+  // Header
+  std::getline(dataset, line);
+  os << line << std::endl;
 
-      for (auto &domain : domains)
-        converters.push_back(domain->makeConverter());
+  // Data, streamed one row at a time
+  while (std::getline(dataset, line)) {
+    std::stringstream ss(line);
 
-      converters.push_back(
-        std::get<decltype("labels"_t)>(*decodable_model_cfg)->makeConverter());
+    bool first = true;
+    std::string input;
+    for (const auto &converter : converters) {
+      std::getline(ss, input, '\t');
+      os << (first ? '\0' : '\t') << converter->convert(input);
+      first = false;
     }
 
-    std::fstream dataset(argv[2]);
-    std::string line;
+    os << std::endl;
+  }
+
+  os << std::endl;
+}
+
+/*
+\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\
+ -------------------------------------------------------------------------------
+                              PRINTER / SERIALIZER
+ -------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
+*/
+
+// Files written and avoided are only reported with --stats
+static void printModel(config::ModelConfigPtr model_cfg,
+                       const std::string &output_dir,
+                       std::size_t num_threads,
+                       bool statistics,
+                       std::ostream &os,
+                       std::ostream &log) {
+  if (output_dir.empty()) {
+    model_cfg->accept(lang::ModelConfigSerializer(os));
+    return;
+  }
+
+  auto printer = num_threads == 1
+    ? std::make_shared<lang::MultipleFilePrinter>(output_dir)
+    : std::make_shared<lang::MultipleFilePrinter>(output_dir, num_threads);
+  model_cfg->accept(lang::ModelConfigSerializer(printer));
+  if (!statistics) return;
+
+  auto written = printer->statistics();
+  log << written.files_written << " files ("
+      << written.bytes_written << " bytes) written, "
+      << written.files_avoided << " duplicated files ("
+      << written.bytes_avoided << " bytes) avoided"
+      << std::endl;
+}
+
+/*
+\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\
+ -------------------------------------------------------------------------------
+                                     BATCH
+ -------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
+*/
+
+struct Job {
+  std::string model;
+  std::string dataset;
+  std::string output_dir;
+};
+
+/*----------------------------------------------------------------------------*/
+
+// One job per line: model, dataset and output_dir separated by tabs.
+// Dataset and output_dir may be omitted or written as `-`. Jobs run
+// concurrently, so no two of them may write to the same output_dir.
+static std::vector<Job> readManifest(const std::string &manifest_path) {
+  std::ifstream manifest(manifest_path);
+  if (!manifest)
+    throw std::invalid_argument("Could not open manifest " + manifest_path);
+
+  std::vector<Job> jobs;
+  std::set<std::string> output_dirs;
 
-    // Header
-    std::getline(dataset, line);
-    std::cout << line << std::endl;
+  std::string line;
+  while (std::getline(manifest, line)) {
+    if (!line.empty() && line.back() == '\r') line.pop_back();
+    if (line.empty() || line[0] == '#') continue;
+
+    std::vector<std::string> fields;
+    std::stringstream ss(line);
+    for (std::string field; std::getline(ss, field, '\t'); )
+      fields.push_back(field == "-" ? "" : field);
+
+    if (fields.empty() || fields[0].empty() || fields.size() > 3)
+      throw std::invalid_argument("Invalid job in manifest: " + line);
+
+    fields.resize(3);
+
+    auto output_dir = lang::cleanPath(fields[2]);
+    while (output_dir.size() > 1 && output_dir.back() == '/')
+      output_dir.pop_back();
+    if (!output_dir.empty() && !output_dirs.insert(output_dir).second)
+      throw std::invalid_argument(
+        "Output directory of more than one job in manifest: " + fields[2]);
+
+    jobs.push_back({ fields[0], fields[1], fields[2] });
+  }
+
+  return jobs;
+}
 
-    // Data
-    while (std::getline(dataset, line)) {
-      std::stringstream ss(line);
+/*----------------------------------------------------------------------------*/
+
+static void runJob(lang::Interpreter &interpreter, const Job &job,
+                   std::size_t footprint_rows, bool statistics,
+                   std::ostream &os, std::ostream &log) {
+  auto model_cfg = interpreter.evalModel(job.model);
+
+  if (footprint_rows > 0) {
+    lang::ModelConfigProfiler profiler;
+    profiler.profile(model_cfg);
+    profiler.report(log, footprint_rows);
+  }
+  if (!job.dataset.empty()) convertDataset(model_cfg, job.dataset, os);
+
+  // Jobs already run in parallel, so each printer uses a single thread
+  printModel(model_cfg, job.output_dir, 1, statistics, os, log);
+}
+
+/*----------------------------------------------------------------------------*/
+
+// Converted datasets may be large, so outputs of jobs waiting for the
+// previous ones are kept on disk instead of in memory
+static std::string makeSpoolFile() {
+  auto tmp_dir = std::getenv("TMPDIR");
+  std::string path = std::string(tmp_dir ? tmp_dir : "/tmp")
+                   + "/tops-lang-XXXXXX";
+
+  auto fd = ::mkstemp(&path[0]);
+  if (fd == -1) throw std::runtime_error("Could not create " + path);
+  ::close(fd);
+
+  return path;
+}
+
+/*----------------------------------------------------------------------------*/
+
+static void copySpoolFile(const std::string &spool_path, std::ostream &os) {
+  std::ifstream src(spool_path, std::ios::binary);
+
+  // Copying an empty buffer would set the failbit of the destination
+  if (src.peek() != std::ifstream::traits_type::eof()) os << src.rdbuf();
+  os << std::flush;
+
+  src.close();
+  std::remove(spool_path.c_str());
+}
 
-      bool first = true;
-      std::string input;
-      for (const auto &converter : converters) {
-        std::getline(ss, input, '\t');
-        std::cout << (first ? '\0' : '\t') << converter->convert(input);
-        first = false;
+/*----------------------------------------------------------------------------*/
+
+// Outputs of jobs are written in the order of the manifest, each one as
+// soon as all the previous ones are complete. Until then, they are kept
+// in spool files. Footprints of models are reported in the log of their
+// jobs when footprint_rows is not 0.
+static bool runBatch(lang::Interpreter &interpreter,
+                     const std::string &manifest_path,
+                     std::size_t footprint_rows, bool statistics) {
+  auto jobs = readManifest(manifest_path);
+
+  struct Output {
+    std::string spool_path;  // Empty if the job failed to create it
+    std::string log;
+    bool ok;
+  };
+
+  std::mutex mutex;
+  std::size_t next_output = 0;
+  std::map<std::size_t, Output> outputs;
+  bool all_ok = true;
+
+  auto finish = [&] (std::size_t i, Output output) {
+    std::lock_guard<std::mutex> lock(mutex);
+    all_ok = all_ok && output.ok;
+    outputs.emplace(i, std::move(output));
+
+    for (auto it = outputs.find(next_output); it != outputs.end();
+         it = outputs.find(++next_output)) {
+      if (!it->second.spool_path.empty())
+        copySpoolFile(it->second.spool_path, std::cout);
+      std::cerr << it->second.log << std::flush;
+      outputs.erase(it);
+    }
+  };
+
+  concurrency::ThreadPool pool;
+  for (std::size_t i = 0; i < jobs.size(); i++) {
+    pool.enqueue([&interpreter, &jobs, &finish,
+                  footprint_rows, statistics, i] {
+      const auto &job = jobs[i];
+      std::string spool_path;
+      std::ostringstream log;
+      bool ok = true;
+
+      auto start = std::chrono::steady_clock::now();
+      try {
+        spool_path = makeSpoolFile();
+        std::ofstream os(spool_path, std::ios::binary);
+        runJob(interpreter, job, footprint_rows, statistics, os, log);
+
+        os.close();
+        if (!os) throw std::runtime_error("Could not write " + spool_path);
+      } catch (chaiscript::exception::eval_error &e) {
+        log << e.pretty_print() << std::endl;
+        ok = false;
+      } catch (std::exception &e) {
+        log << e.what() << std::endl;
+        ok = false;
       }
+      auto end = std::chrono::steady_clock::now();
+
+      log << "job " << i + 1 << " (" << job.model << "): "
+          << (ok ? "done" : "failed") << " in "
+          << std::chrono::duration<double, std::milli>(end - start).count()
+          << " ms" << std::endl;
+
+      finish(i, { spool_path, log.str(), ok });
+    });
+  }
+  pool.wait();
 
+  return all_ok;
+}
+
+/*
+\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\
+ -------------------------------------------------------------------------------
+                                   PROFILING
+ -------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
+*/
+
+// Number of files listed by --stats
+static const std::size_t max_slowest_files = 10;
+
+// Number of rows of each table printed by --memory
+static const std::size_t max_footprint_rows = 15;
+
+/*----------------------------------------------------------------------------*/
+
+static void writeTrace(const lang::Tracer &tracer,
+                       const std::string &trace_path, bool statistics) {
+  if (!trace_path.empty()) {
+    std::ofstream trace(trace_path);
+    if (!trace)
+      throw std::invalid_argument("Could not open trace " + trace_path);
+    tracer.writeChromeTrace(trace);
+  }
+
+  if (statistics) tracer.writeStatistics(std::cerr, max_slowest_files);
+}
+
+/*
+\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\
+ -------------------------------------------------------------------------------
+                                      MAIN
+ -------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
+*/
+
+int main(int argc, char **argv) try {
+  auto program = argv[0];
+
+  // Tracing options precede the mode and are removed from the arguments
+  std::string trace_path;
+  bool statistics = false;
+  bool footprint = false;
+  while (argc >= 2) {
+    std::string option(argv[1]);
+    if (option == "--trace" && argc >= 3) {
+      trace_path = argv[2];
+      argc -= 2; argv += 2;
+    } else if (option == "--stats") {
+      statistics = true;
+      argc -= 1; argv += 1;
+    } else if (option == "--memory") {
+      footprint = true;
+      argc -= 1; argv += 1;
+    } else {
+      break;
+    }
+  }
+
+  if (argc <= 1 || argc >= 5) {
+    std::cerr << "USAGE: " << program
+              << " [--trace out.json] [--stats] [--memory] model_config"
+              << " [dataset] [output_dir]"
+              << std::endl
+              << "       " << program << " --deps model_config"
+              << std::endl
+              << "       " << program
+              << " [--trace out.json] [--stats] [--memory] --batch manifest"
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  /*--------------------------------------------------------------------------*/
+  /*                               DEPENDENCIES                               */
+  /*--------------------------------------------------------------------------*/
+
+  if (argc == 3 && std::string(argv[1]) == "--deps") {
+    // Make-style rules, found without evaluating any file
+    auto graph = lang::DependencyScanner().scanGraph(argv[2]);
+    for (const auto &file : graph.files) {
+      std::cout << file << ":";
+      for (const auto &dependency : graph.dependencies[file])
+        std::cout << " " << dependency;
       std::cout << std::endl;
     }
+    for (const auto &file : graph.dynamic)
+      std::cerr << file << ": References files through computed paths"
+                << std::endl;
+    return EXIT_SUCCESS;
+  }
+
+  // Evaluated models are cached only when explicitly requested
+  auto cache_dir = std::getenv("TOPS_CACHE_DIR");
+  auto interpreter = cache_dir ? lang::Interpreter(cache_dir)
+                               : lang::Interpreter();
+
+  // Submodels not needed by the conversion are loaded only when printed
+  interpreter.setLazy(std::getenv("TOPS_LAZY") != nullptr);
+
+  // Each model is allocated in a single arena, released with it
+  interpreter.setArena(std::getenv("TOPS_ARENA") != nullptr);
+
+  // Spans are only recorded when some report was requested
+  auto tracer = std::make_shared<lang::Tracer>();
+  if (!trace_path.empty() || statistics) interpreter.setTracer(tracer);
 
-    std::cout << std::endl;
+  /*--------------------------------------------------------------------------*/
+  /*                                  BATCH                                   */
+  /*--------------------------------------------------------------------------*/
+
+  if (argc == 3 && std::string(argv[1]) == "--batch") {
+    // Submodels shared by different jobs are evaluated only once
+    interpreter.setMemoize(true);
+    auto ok = runBatch(interpreter, argv[2],
+                       footprint ? max_footprint_rows : 0, statistics);
+    writeTrace(*tracer, trace_path, statistics);
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
   }
 
   /*--------------------------------------------------------------------------*/
-  /*                           PRINTER / SERIALIZER                           */
+  /*                                  SINGLE                                  */
   /*--------------------------------------------------------------------------*/
 
-  switch (argc) {
-    case 2: /* fall through */
-    case 3: model_cfg->accept(lang::ModelConfigSerializer{}); break;
-    case 4: model_cfg->accept(lang::ModelConfigSerializer(argv[3])); break;
+  auto model_cfg = interpreter.evalModel(argv[1]);
+  writeTrace(*tracer, trace_path, statistics);
+
+  if (footprint) {
+    lang::ModelConfigProfiler profiler;
+    profiler.profile(model_cfg);
+    profiler.report(std::cerr, max_footprint_rows);
   }
 
+  if (argc >= 3) convertDataset(model_cfg, argv[2], std::cout);
+
+  printModel(model_cfg, argc == 4 ? argv[3] : "",
+             std::thread::hardware_concurrency(), statistics,
+             std::cout, std::cerr);
+
   return EXIT_SUCCESS;
 }
 catch(chaiscript::exception::eval_error &e) {
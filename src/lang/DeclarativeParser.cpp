@@ -0,0 +1,584 @@
+/***********************************************************************/
+/*  Copyright 2016 ToPS                                                */
+/*                                                                     */
+/*  This program is free software; you can redistribute it and/or      */
+/*  modify it under the terms of the GNU  General Public License as    */
+/*  published by the Free Software Foundation; either version 3 of     */
+/*  the License, or (at your option) any later version.                */
+/*                                                                     */
+/*  This program is distributed in the hope that it will be useful,    */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of     */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the      */
+/*  GNU General Public License for more details.                       */
+/*                                                                     */
+/*  You should have received a copy of the GNU General Public License  */
+/*  along with this program; if not, write to the Free Software        */
+/*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,         */
+/*  MA 02110-1301, USA.                                                */
+/***********************************************************************/
+
+// Interface header
+#include "lang/DeclarativeParser.hpp"
+
+// Standard headers
+#include <string>
+#include <vector>
+#include <cctype>
+#include <limits>
+#include <cstdlib>
+#include <fstream>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+#include <initializer_list>
+
+namespace lang {
+
+/*----------------------------------------------------------------------------*/
+/*                               LOCAL FUNCTIONS                              */
+/*----------------------------------------------------------------------------*/
+
+static bool matches(const char *name, std::size_t size, const char *word) {
+  return std::string::traits_type::length(word) == size
+      && std::string::traits_type::compare(name, word, size) == 0;
+}
+
+/*----------------------------------------------------------------------------*/
+
+// Whether integer arithmetic would overflow a long long
+static bool overflows(char operation, long long lhs, long long rhs) {
+  constexpr auto max = std::numeric_limits<long long>::max();
+  constexpr auto min = std::numeric_limits<long long>::min();
+
+  switch (operation) {
+    case '+': return rhs > 0 ? lhs > max - rhs : lhs < min - rhs;
+    case '-': return rhs < 0 ? lhs > max + rhs : lhs < min + rhs;
+    case '*':
+      if (lhs == 0 || rhs == 0) return false;
+      if (lhs > 0)
+        return rhs > 0 ? lhs > max / rhs : rhs < min / lhs;
+      return rhs > 0 ? lhs < min / rhs : lhs < max / rhs;
+    case '/': return lhs == min && rhs == -1;
+  }
+  return false;
+}
+
+/*----------------------------------------------------------------------------*/
+
+// Helpers that can be called from a declarative file
+static bool isHelper(const char *name, std::size_t size) {
+  for (auto helper : { "model", "explicit", "geometric", "fixed",
+                       "max_length", "lib", "tree", "table",
+                       "discrete_domain", "range_domain" })
+    if (matches(name, size, helper)) return true;
+  return false;
+}
+
+/*----------------------------------------------------------------------------*/
+
+// Global constants that can be used in a declarative file
+static bool isConstant(const char *name, std::size_t size) {
+  return matches(name, size, "emission") || matches(name, size, "duration");
+}
+
+/*----------------------------------------------------------------------------*/
+/*                                INNER STRUCTS                               */
+/*----------------------------------------------------------------------------*/
+
+std::string DeclarativeParser::Value::string() const {
+  if (kind == Kind::Condition)
+    return values[0].string() + " | " + values[1].string();
+  return std::string(data, size);
+}
+
+/*----------------------------------------------------------------------------*/
+
+double DeclarativeParser::Value::number() const {
+  return kind == Kind::Integer ? static_cast<double>(integer) : real;
+}
+
+/*----------------------------------------------------------------------------*/
+
+bool DeclarativeParser::Value::isString() const {
+  return kind == Kind::String;
+}
+
+/*----------------------------------------------------------------------------*/
+
+bool DeclarativeParser::Value::isNumber() const {
+  return kind == Kind::Integer || kind == Kind::Real;
+}
+
+/*----------------------------------------------------------------------------*/
+
+bool DeclarativeParser::Value::isCondition() const {
+  return kind == Kind::Condition;
+}
+
+/*----------------------------------------------------------------------------*/
+
+bool DeclarativeParser::Value::isCall(const std::string &name) const {
+  return kind == Kind::Call && matches(data, size, name.c_str());
+}
+
+/*----------------------------------------------------------------------------*/
+/*                                CONSTRUCTORS                                */
+/*----------------------------------------------------------------------------*/
+
+DeclarativeParser::DeclarativeParser(std::string filepath)
+    : filepath_(std::move(filepath)), it_(nullptr), end_(nullptr) {
+}
+
+/*----------------------------------------------------------------------------*/
+/*                              CONCRETE METHODS                              */
+/*----------------------------------------------------------------------------*/
+
+bool DeclarativeParser::parse() {
+  std::ifstream file(filepath_, std::ios::binary | std::ios::ate);
+  if (!file) return false;
+
+  buffer_.resize(static_cast<std::size_t>(file.tellg()));
+  file.seekg(0);
+  file.read(&buffer_[0], static_cast<std::streamsize>(buffer_.size()));
+
+  it_ = buffer_.data();
+  end_ = buffer_.data() + buffer_.size();
+
+  try {
+    skipBlanks();
+    while (it_ != end_) {
+      parseStatement();
+      skipBlanks();
+    }
+  } catch (const unsupported_feature &) {
+    statements_.clear();
+    strings_.clear();
+    return false;
+  }
+
+  return true;
+}
+
+/*----------------------------------------------------------------------------*/
+
+const std::string &DeclarativeParser::filepath() const {
+  return filepath_;
+}
+
+/*----------------------------------------------------------------------------*/
+
+const DeclarativeParser::Statements &DeclarativeParser::statements() const {
+  return statements_;
+}
+
+/*----------------------------------------------------------------------------*/
+
+const DeclarativeParser::Value *
+DeclarativeParser::find(const std::string &name) const {
+  auto it = statements_.find(name);
+  return it == statements_.end() ? nullptr : &it->second;
+}
+
+/*----------------------------------------------------------------------------*/
+
+std::string DeclarativeParser::modelType() const {
+  auto value = find("model_type");
+  return value && value->isString() ? value->string() : "";
+}
+
+/*----------------------------------------------------------------------------*/
+
+void DeclarativeParser::parseStatement() {
+  auto name = it_;
+  auto size = parseIdentifier();
+
+  skipBlanks();
+  consume('=');
+  if (next() == '=') unsupported();
+
+  auto value = parseExpression();
+
+  skipBlanks();
+  if (next() == ';') consume(';');
+
+  statements_[std::string(name, size)] = std::move(value);
+}
+
+/*----------------------------------------------------------------------------*/
+
+DeclarativeParser::Value DeclarativeParser::parseExpression() {
+  auto lhs = parseSum();
+
+  while (true) {
+    skipBlanks();
+    if (next() == '|' && next(2) != '|' && next(2) != '=') {
+      consume('|');
+      lhs = condition(lhs, parseSum());
+    } else if (next() == '-' && next(2) == '>') {
+      consume('-');
+      consume('>');
+      lhs = condition(parseSum(), lhs);
+    } else {
+      return lhs;
+    }
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+
+DeclarativeParser::Value DeclarativeParser::parseSum() {
+  auto lhs = parseProduct();
+
+  while (true) {
+    skipBlanks();
+    if (next() == '+') {
+      consume('+');
+      lhs = calculate('+', lhs, parseProduct());
+    } else if (next() == '-' && next(2) != '>') {
+      consume('-');
+      lhs = calculate('-', lhs, parseProduct());
+    } else {
+      return lhs;
+    }
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+
+DeclarativeParser::Value DeclarativeParser::parseProduct() {
+  auto lhs = parseUnary();
+
+  while (true) {
+    skipBlanks();
+    if (next() == '*' || next() == '/') {
+      auto operation = next();
+      consume(operation);
+      lhs = calculate(operation, lhs, parseUnary());
+    } else {
+      return lhs;
+    }
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+
+DeclarativeParser::Value DeclarativeParser::parseUnary() {
+  skipBlanks();
+  if (next() != '-') return parsePrimary();
+
+  consume('-');
+  Value zero;
+  zero.kind = Value::Kind::Integer;
+  return calculate('-', zero, parseUnary());
+}
+
+/*----------------------------------------------------------------------------*/
+
+DeclarativeParser::Value DeclarativeParser::parsePrimary() {
+  skipBlanks();
+
+  auto c = next();
+  if (c == '"') return parseString();
+  if (c == '[') return parseContainer();
+  if (std::isdigit(static_cast<unsigned char>(c))) return parseNumber();
+
+  if (c == '(') {
+    consume('(');
+    auto value = parseExpression();
+    skipBlanks();
+    consume(')');
+    return value;
+  }
+
+  auto name = it_;
+  auto size = parseIdentifier();
+
+  skipBlanks();
+  if (next() == '(' && isHelper(name, size))
+    return parseCall(name, size);
+
+  // Constants evaluate to their own names
+  if (next() != '(' && isConstant(name, size)) {
+    Value value;
+    value.kind = Value::Kind::String;
+    value.data = name;
+    value.size = size;
+    return value;
+  }
+
+  unsupported();
+}
+
+/*----------------------------------------------------------------------------*/
+
+DeclarativeParser::Value DeclarativeParser::parseString() {
+  consume('"');
+
+  Value value;
+  value.kind = Value::Kind::String;
+  value.data = it_;
+
+  while (next() != '"') {
+    // Escapes and interpolations are left to ChaiScript
+    if (it_ == end_ || next() == '\\' || (next() == '$' && next(2) == '{'))
+      unsupported();
+    it_++;
+  }
+
+  value.size = static_cast<std::size_t>(it_ - value.data);
+  consume('"');
+  return value;
+}
+
+/*----------------------------------------------------------------------------*/
+
+DeclarativeParser::Value DeclarativeParser::parseNumber() {
+  auto begin = it_;
+  bool integer = true;
+
+  auto digit = [this] (std::size_t n) {
+    return std::isdigit(static_cast<unsigned char>(next(n))) != 0;
+  };
+
+  while (digit(1)) it_++;
+
+  if (next() == '.' && digit(2)) {
+    integer = false;
+    it_++;
+    while (digit(1)) it_++;
+  }
+
+  if ((next() == 'e' || next() == 'E')
+      && (digit(2) || ((next(2) == '+' || next(2) == '-') && digit(3)))) {
+    integer = false;
+    it_ += 2;
+    while (digit(1)) it_++;
+  }
+
+  // Suffixes and other bases are left to ChaiScript
+  if (std::isalnum(static_cast<unsigned char>(next())) || next() == '_'
+      || next() == '.')
+    unsupported();
+
+  Value value;
+  if (integer) {
+    value.kind = Value::Kind::Integer;
+    for (auto c = begin; c != it_; c++) {
+      long long digit = *c - '0';
+      if (value.integer > (std::numeric_limits<long long>::max() - digit) / 10)
+        error("Integer literal out of range");
+      value.integer = 10 * value.integer + digit;
+    }
+  } else {
+    value.kind = Value::Kind::Real;
+    value.real = std::strtod(begin, nullptr);
+  }
+  return value;
+}
+
+/*----------------------------------------------------------------------------*/
+
+DeclarativeParser::Value DeclarativeParser::parseContainer() {
+  consume('[');
+
+  Value value;
+  value.kind = Value::Kind::List;
+
+  skipBlanks();
+  if (next() == ']') {
+    consume(']');
+    return value;
+  }
+
+  bool first = true;
+  while (true) {
+    auto element = parseExpression();
+
+    skipBlanks();
+    bool pair = next() == ':';
+
+    if (first) {
+      value.kind = pair ? Value::Kind::Map : Value::Kind::List;
+      first = false;
+    } else if (pair != (value.kind == Value::Kind::Map)) {
+      unsupported();
+    }
+
+    if (pair) {
+      if (!element.isString() && !element.isCondition()) unsupported();
+      consume(':');
+      value.keys.push_back(std::move(element));
+      value.values.push_back(parseExpression());
+      skipBlanks();
+    } else {
+      value.values.push_back(std::move(element));
+    }
+
+    if (next() != ',') break;
+    consume(',');
+  }
+
+  consume(']');
+  return value;
+}
+
+/*----------------------------------------------------------------------------*/
+
+DeclarativeParser::Value DeclarativeParser::parseCall(const char *name,
+                                                      std::size_t size) {
+  consume('(');
+
+  Value value;
+  value.kind = Value::Kind::Call;
+  value.data = name;
+  value.size = size;
+
+  skipBlanks();
+  if (next() != ')') {
+    value.values.push_back(parseExpression());
+    skipBlanks();
+    while (next() == ',') {
+      consume(',');
+      value.values.push_back(parseExpression());
+      skipBlanks();
+    }
+  }
+
+  consume(')');
+  return value;
+}
+
+/*----------------------------------------------------------------------------*/
+
+std::size_t DeclarativeParser::parseIdentifier() {
+  auto begin = it_;
+
+  if (!std::isalpha(static_cast<unsigned char>(next())) && next() != '_')
+    unsupported();
+
+  while (std::isalnum(static_cast<unsigned char>(next())) || next() == '_')
+    it_++;
+
+  return static_cast<std::size_t>(it_ - begin);
+}
+
+/*----------------------------------------------------------------------------*/
+
+DeclarativeParser::Value DeclarativeParser::concatenate(
+    const Value &lhs, const Value &rhs, const char *separator) {
+  if (!lhs.isString() || !rhs.isString()) unsupported();
+
+  strings_.emplace_back();
+  auto &string = strings_.back();
+  string.reserve(lhs.size + rhs.size + 3);
+  string.append(lhs.data, lhs.size).append(separator)
+        .append(rhs.data, rhs.size);
+
+  Value value;
+  value.kind = Value::Kind::String;
+  value.data = string.data();
+  value.size = string.size();
+  return value;
+}
+
+/*----------------------------------------------------------------------------*/
+
+DeclarativeParser::Value DeclarativeParser::condition(const Value &target,
+                                                      const Value &context) {
+  // Chained conditions are left to ChaiScript
+  if (!target.isString() || !context.isString()) unsupported();
+
+  Value value;
+  value.kind = Value::Kind::Condition;
+  value.values = { target, context };
+  return value;
+}
+
+/*----------------------------------------------------------------------------*/
+
+DeclarativeParser::Value DeclarativeParser::calculate(
+    char operation, const Value &lhs, const Value &rhs) {
+  if (operation == '+' && lhs.isString() && rhs.isString())
+    return concatenate(lhs, rhs, "");
+
+  if (!lhs.isNumber() || !rhs.isNumber()) unsupported();
+
+  Value value;
+
+  // Integer arithmetic follows ChaiScript, where 1/2 == 0
+  if (lhs.kind == Value::Kind::Integer && rhs.kind == Value::Kind::Integer) {
+    value.kind = Value::Kind::Integer;
+    if (overflows(operation, lhs.integer, rhs.integer))
+      error("Integer overflow");
+
+    switch (operation) {
+      case '+': value.integer = lhs.integer + rhs.integer; break;
+      case '-': value.integer = lhs.integer - rhs.integer; break;
+      case '*': value.integer = lhs.integer * rhs.integer; break;
+      case '/': if (rhs.integer == 0) unsupported();
+                value.integer = lhs.integer / rhs.integer; break;
+    }
+    return value;
+  }
+
+  value.kind = Value::Kind::Real;
+  switch (operation) {
+    case '+': value.real = lhs.number() + rhs.number(); break;
+    case '-': value.real = lhs.number() - rhs.number(); break;
+    case '*': value.real = lhs.number() * rhs.number(); break;
+    case '/': value.real = lhs.number() / rhs.number(); break;
+  }
+  return value;
+}
+
+/*----------------------------------------------------------------------------*/
+
+void DeclarativeParser::skipBlanks() {
+  while (it_ != end_) {
+    if (std::isspace(static_cast<unsigned char>(next()))) {
+      it_++;
+    } else if (next() == '/' && next(2) == '/') {
+      while (it_ != end_ && next() != '\n') it_++;
+    } else if (next() == '/' && next(2) == '*') {
+      it_ += 2;
+      while (!(next() == '*' && next(2) == '/')) {
+        if (it_ == end_) unsupported();
+        it_++;
+      }
+      it_ += 2;
+    } else {
+      return;
+    }
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+
+void DeclarativeParser::consume(char c) {
+  if (it_ == end_ || next() != c) unsupported();
+  it_++;
+}
+
+/*----------------------------------------------------------------------------*/
+
+char DeclarativeParser::next(std::size_t n) const {
+  return static_cast<std::size_t>(end_ - it_) >= n ? it_[n - 1] : '\0';
+}
+
+/*----------------------------------------------------------------------------*/
+
+void DeclarativeParser::unsupported() const {
+  throw unsupported_feature();
+}
+
+/*----------------------------------------------------------------------------*/
+
+void DeclarativeParser::error(const std::string &reason) const {
+  auto line = 1 + std::count(buffer_.data(), it_, '\n');
+  throw std::logic_error(
+      filepath_ + ":" + std::to_string(line) + ": " + reason);
+}
+
+/*----------------------------------------------------------------------------*/
+
+}  // namespace lang
@@ -0,0 +1,170 @@
+/***********************************************************************/
+/*  Copyright 2016 ToPS                                                */
+/*                                                                     */
+/*  This program is free software; you can redistribute it and/or      */
+/*  modify it under the terms of the GNU  General Public License as    */
+/*  published by the Free Software Foundation; either version 3 of     */
+/*  the License, or (at your option) any later version.                */
+/*                                                                     */
+/*  This program is distributed in the hope that it will be useful,    */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of     */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the      */
+/*  GNU General Public License for more details.                       */
+/*                                                                     */
+/*  You should have received a copy of the GNU General Public License  */
+/*  along with this program; if not, write to the Free Software        */
+/*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,         */
+/*  MA 02110-1301, USA.                                                */
+/***********************************************************************/
+
+// Interface header
+#include "lang/DependencyScanner.hpp"
+
+// Standard headers
+#include <set>
+#include <string>
+#include <vector>
+#include <cctype>
+#include <fstream>
+#include <algorithm>
+#include <iterator>
+
+// Internal headers
+#include "lang/Util.hpp"
+
+namespace lang {
+
+/*----------------------------------------------------------------------------*/
+/*                               LOCAL FUNCTIONS                              */
+/*----------------------------------------------------------------------------*/
+
+static bool isIdentifier(char c) {
+  return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+}
+
+/*----------------------------------------------------------------------------*/
+
+static bool isReference(const std::string &helper) {
+  return helper == "model" || helper == "explicit" || helper == "lib"
+      || helper == "tree" || helper == "table" || helper == "use";
+}
+
+/*----------------------------------------------------------------------------*/
+/*                              CONCRETE METHODS                              */
+/*----------------------------------------------------------------------------*/
+
+std::vector<DependencyScanner::Dependency>
+DependencyScanner::scan(const std::string &filepath) {
+  return scan(filepath, extractDir(filepath));
+}
+
+/*----------------------------------------------------------------------------*/
+
+std::vector<DependencyScanner::Dependency>
+DependencyScanner::scan(const std::string &filepath,
+                        const std::string &root_dir) {
+  std::ifstream file(filepath);
+  std::string content { std::istreambuf_iterator<char>(file),
+                        std::istreambuf_iterator<char>() };
+
+  std::vector<Dependency> dependencies;
+
+  auto it = content.begin();
+  auto end = content.end();
+
+  auto skipSpaces = [&it, &end] {
+    while (it != end && std::isspace(static_cast<unsigned char>(*it))) it++;
+  };
+
+  while (it != end) {
+    if (*it == '/' && it + 1 != end && *(it + 1) == '/') {
+      while (it != end && *it != '\n') it++;
+    } else if (*it == '/' && it + 1 != end && *(it + 1) == '*') {
+      it += 2;
+      while (it != end && !(*it == '*' && it + 1 != end && *(it + 1) == '/'))
+        it++;
+      if (it != end) it += 2;
+    } else if (*it == '"') {
+      for (it++; it != end && *it != '"'; it++)
+        if (*it == '\\' && it + 1 != end) it++;
+      if (it != end) it++;
+    } else if (isIdentifier(*it)) {
+      auto begin = it;
+      while (it != end && isIdentifier(*it)) it++;
+      std::string helper(begin, it);
+      if (!isReference(helper)) continue;
+
+      skipSpaces();
+      if (it == end || *it != '(') continue;
+      it++;
+      skipSpaces();
+      if (it == end || *it != '"') {
+        dependencies.push_back({ helper, "", root_dir, true });
+        continue;
+      }
+
+      auto name_begin = ++it;
+      while (it != end && *it != '"' && *it != '\n') it++;
+      if (it == end || *it != '"') continue;
+      std::string name(name_begin, it++);
+
+      // Literals followed by anything but the next argument are expressions
+      skipSpaces();
+      if (it == end || (*it != ')' && *it != ',')) {
+        dependencies.push_back({ helper, "", root_dir, true });
+        continue;
+      }
+
+      // Trees and scripts resolve their references as the file using them
+      auto path = root_dir + name;
+      if (helper == "tree" || helper == "use")
+        dependencies.push_back({ helper, path, root_dir });
+      else
+        dependencies.push_back({ helper, path, extractDir(path) });
+    } else {
+      it++;
+    }
+  }
+
+  return dependencies;
+}
+
+/*----------------------------------------------------------------------------*/
+
+DependencyScanner::Graph
+DependencyScanner::scanGraph(const std::string &filepath) {
+  Graph graph;
+  std::set<std::string> visited;
+  scanGraph(filepath, extractDir(filepath), visited, graph);
+  return graph;
+}
+
+/*----------------------------------------------------------------------------*/
+
+void DependencyScanner::scanGraph(const std::string &filepath,
+                                  const std::string &root_dir,
+                                  std::set<std::string> &visited,
+                                  Graph &graph) {
+  // Trees may be used from different directories, so both identify a node
+  if (!visited.insert(filepath + '\n' + root_dir).second) return;
+
+  auto &dependencies = graph.dependencies[filepath];
+  for (const auto &dependency : scan(filepath, root_dir)) {
+    if (dependency.dynamic) {
+      graph.dynamic.insert(filepath);
+      continue;
+    }
+
+    dependencies.insert(dependency.filepath);
+    scanGraph(dependency.filepath, dependency.root_dir, visited, graph);
+  }
+
+  // Post-order: every dependency was already listed (cycles aside)
+  if (std::find(graph.files.begin(), graph.files.end(), filepath)
+      == graph.files.end())
+    graph.files.push_back(filepath);
+}
+
+/*----------------------------------------------------------------------------*/
+
+}  // namespace lang
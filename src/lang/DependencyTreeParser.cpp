@@ -60,6 +60,8 @@ DependencyTreeParser::DependencyTreeParser(Interpreter* interpreter,
 /*----------------------------------------------------------------------------*/
 
 config::DependencyTreeConfigPtr DependencyTreeParser::parse() {
+  Tracer::Span span(interpreter_->tracer_, "parse", root_dir_ + filename_);
+
   for (auto line : content_) {
     line_++;
     column_ = 1;
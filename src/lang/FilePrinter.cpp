@@ -23,8 +23,6 @@
 // Standard header
 #include <memory>
 #include <string>
-#include <ostream>
-#include <algorithm>
 
 namespace lang {
 
@@ -37,6 +35,12 @@ void FilePrinter::changeOstream(const std::string &/* path */) {
 
 /*----------------------------------------------------------------------------*/
 
+void FilePrinter::print(const config::option::Probabilities &probabilities) {
+  print<config::option::Probabilities>(probabilities);
+}
+
+/*----------------------------------------------------------------------------*/
+
 void FilePrinter::startPrinting() {
 }
 
@@ -58,14 +62,21 @@ void FilePrinter::print(const std::string &string) {
 
 /*----------------------------------------------------------------------------*/
 
+void FilePrinter::print(const config::Condition &condition) {
+  // Conditions are printed in the syntax "target | context" they come from
+  print(condition.str());
+}
+
+/*----------------------------------------------------------------------------*/
+
 void FilePrinter::print(float num) {
-  *os_ << std::fixed << num;
+  *os_ << static_cast<double>(num);
 }
 
 /*----------------------------------------------------------------------------*/
 
 void FilePrinter::print(double num) {
-  *os_ << std::fixed << num;
+  *os_ << num;
 }
 
 /*----------------------------------------------------------------------------*/
@@ -77,13 +88,14 @@ void FilePrinter::print(unsigned int num) {
 /*----------------------------------------------------------------------------*/
 
 void FilePrinter::print(bool boolean) {
-  *os_ << std::boolalpha << boolean;
+  *os_ << boolean;
 }
 
 /*----------------------------------------------------------------------------*/
 
 void FilePrinter::printTag(const std::string &tag, std::size_t count,
                                                    std::size_t max) {
+  tag_ = tag;
   if (count > 0 && count < max) {
     *os_ << option_.middle;
   }
@@ -132,8 +144,7 @@ void FilePrinter::closeSection(char separator) {
 /*----------------------------------------------------------------------------*/
 
 void FilePrinter::indent(unsigned int extra_depth) {
-  std::fill_n(std::ostreambuf_iterator<char>(*os_),
-      2 * (depth_ + extra_depth), ' ');
+  os_->appendSpaces(2 * (depth_ + extra_depth));
 }
 
 /*----------------------------------------------------------------------------*/
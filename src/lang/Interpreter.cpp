@@ -25,6 +25,7 @@
 #include <memory>
 #include <string>
 #include <vector>
+#include <fstream>
 #include <sstream>
 #include <utility>
 #include <typeinfo>
@@ -34,17 +35,22 @@
 
 // Internal headers
 #include "lang/Util.hpp"
+#include "lang/TableFile.hpp"
 #include "lang/ModelConfigRegister.hpp"
 #include "lang/DependencyTreeParser.hpp"
 
 #include "config/StringLiteralSuffix.hpp"
 
+#include "config/Arena.hpp"
 #include "config/Domain.hpp"
+#include "config/Condition.hpp"
+#include "config/SymbolTable.hpp"
 
 #include "config/Options.hpp"
 #include "config/BasicConfig.hpp"
 
 #include "config/ModelConfig.hpp"
+#include "config/LazyModelConfig.hpp"
 #include "config/HMMConfig.hpp"
 #include "config/IIDConfig.hpp"
 #include "config/IMCConfig.hpp"
@@ -74,6 +80,7 @@
 #include "chaiscript/dispatchkit/type_info.hpp"
 #include "chaiscript/dispatchkit/boxed_cast.hpp"
 #include "chaiscript/dispatchkit/boxed_value.hpp"
+#include "chaiscript/dispatchkit/boxed_number.hpp"
 #include "chaiscript/dispatchkit/bootstrap_stl.hpp"
 #include "chaiscript/dispatchkit/type_conversions.hpp"
 #include "chaiscript/dispatchkit/register_function.hpp"
@@ -135,6 +142,48 @@ using get_inner_t = typename get_inner<T>::type;
     module->add(map_conversion<registered_type>()); \
   } while (false)
 
+/*----------------------------------------------------------------------------*/
+/*                               LOCAL FUNCTIONS                              */
+/*----------------------------------------------------------------------------*/
+
+template<typename T>
+const T &unbox(const chaiscript::Boxed_Value &value) {
+  // Exact types are read in place, skipping boxed_cast's conversion lookup
+  if (!value.is_null()
+      && value.get_type_info().bare_equal(chaiscript::user_type<T>()))
+    return *static_cast<const T *>(value.get_const_ptr());
+  return chaiscript::boxed_cast<const T &>(value);
+}
+
+/*----------------------------------------------------------------------------*/
+
+static double unboxNumber(const chaiscript::Boxed_Value &value) {
+  if (!value.is_null()
+      && value.get_type_info().bare_equal(chaiscript::user_type<double>()))
+    return *static_cast<const double *>(value.get_const_ptr());
+  return chaiscript::Boxed_Number(value).get_as<double>();
+}
+
+/*----------------------------------------------------------------------------*/
+
+static config::option::Alphabet makeAlphabet(
+    const std::vector<chaiscript::Boxed_Value> &orig) {
+  config::option::Alphabet alphabet;
+  alphabet.reserve(orig.size());
+  for (auto &element : orig)
+    alphabet.push_back(unbox<std::string>(element));
+  return alphabet;
+}
+
+/*----------------------------------------------------------------------------*/
+
+static chaiscript::Boxed_Value findElement(
+    const std::map<std::string, chaiscript::Boxed_Value> &orig,
+    const std::string &key) {
+  auto it = orig.find(key);
+  return it != orig.end() ? it->second : chaiscript::Boxed_Value();
+}
+
 /*----------------------------------------------------------------------------*/
 /*                              STATIC VARIABLES                              */
 /*----------------------------------------------------------------------------*/
@@ -153,13 +202,76 @@ Interpreter::model_type_map {
   { "MDD"         , Interpreter::ModelType::MDD          }
 };
 
+/*----------------------------------------------------------------------------*/
+/*                                CONSTRUCTORS                                */
+/*----------------------------------------------------------------------------*/
+
+Interpreter::Interpreter()
+    : library_(makeSharedLibrary()) {
+}
+
+/*----------------------------------------------------------------------------*/
+
+Interpreter::Interpreter(const std::string &cache_dir)
+    : library_(makeSharedLibrary()),
+      cache_(std::make_shared<ModelConfigCache>(cache_dir)) {
+}
+
 /*----------------------------------------------------------------------------*/
 /*                              CONCRETE METHODS                              */
 /*----------------------------------------------------------------------------*/
 
 config::ModelConfigPtr Interpreter::evalModel(const std::string &filepath) {
+  Tracer::Span span(tracer_, "evalModel", filepath);
+
+  // Models read from the cache are interned in the same table
+  config::SymbolTable::Scope symbols_scope(std::atomic_load(&symbols_));
+
   checkExtension(filepath);
-  return makeModelConfig(filepath);
+
+  if (!cache_) return makeModelConfig(filepath);
+
+  std::string key;
+  {
+    Tracer::Span load_span(tracer_, "cache_load", filepath);
+    key = cache_->key(filepath);
+    if (key.empty()) return makeModelConfig(filepath);
+    if (auto model_cfg = cache_->load(key)) return model_cfg;
+  }
+
+  auto model_cfg = makeModelConfig(filepath);
+
+  // Storing would evaluate every submodel that lazy mode avoids evaluating
+  if (!lazy_) {
+    Tracer::Span store_span(tracer_, "cache_store", filepath);
+    cache_->store(key, model_cfg);
+  }
+
+  return model_cfg;
+}
+
+/*----------------------------------------------------------------------------*/
+
+void Interpreter::setLazy(bool lazy) {
+  lazy_ = lazy;
+}
+
+/*----------------------------------------------------------------------------*/
+
+void Interpreter::setMemoize(bool memoize) {
+  models_ = memoize ? std::make_shared<ModelMemo>() : nullptr;
+}
+
+/*----------------------------------------------------------------------------*/
+
+void Interpreter::setTracer(TracerPtr tracer) {
+  tracer_ = std::move(tracer);
+}
+
+/*----------------------------------------------------------------------------*/
+
+void Interpreter::setArena(bool arena) {
+  arena_ = arena;
 }
 
 /*----------------------------------------------------------------------------*/
@@ -178,45 +290,138 @@ void Interpreter::checkExtension(const std::string &filepath) {
 
 config::ModelConfigPtr
 Interpreter::makeModelConfig(const std::string &filepath) {
-  auto model_type = findModelType(filepath);
+  if (!models_) return interpretModelConfig(filepath);
+
+  {
+    std::lock_guard<std::mutex> lock(models_->mutex);
+    auto it = models_->models.find(filepath);
+    if (it != models_->models.end()) return it->second;
+  }
+
+  // Submodels are evaluated recursively, so the lock is not held meanwhile
+  auto model_cfg = interpretModelConfig(filepath);
+
+  std::lock_guard<std::mutex> lock(models_->mutex);
+  return models_->models.emplace(filepath, model_cfg).first->second;
+}
+
+/*----------------------------------------------------------------------------*/
+
+config::ModelConfigPtr
+Interpreter::interpretModelConfig(const std::string &filepath) {
+  Tracer::Span span(tracer_, "file", filepath);
+
+  // Lazy submodels are evaluated later, maybe in other threads
+  config::SymbolTable::Scope symbols_scope(std::atomic_load(&symbols_));
+
+  // Submodels evaluated meanwhile share the arena opened by the outermost,
+  // unless they are memoized and may outlive it (see setArena)
+  std::unique_ptr<config::Arena::Scope> arena_scope;
+  if (arena_ && models_) {
+    arena_scope = std::make_unique<config::Arena::Scope>(
+      std::make_shared<config::Arena>());
+  } else if (arena_) {
+    arena_scope = std::make_unique<config::Arena::Scope>();
+  }
+
+  // Files using dynamic features fall back to ChaiScript
+  auto parser = std::make_shared<DeclarativeParser>(filepath);
+  {
+    Tracer::Span parse_span(tracer_, "parse", filepath);
+    if (!parser->parse()) parser = nullptr;
+  }
+
+  auto model_type = findModelType(filepath, parser);
 
   switch (model_type) {
     using namespace config;  // NOLINT(build/namespaces)
-    case ModelType::GHMM:        return fillConfig<GHMMConfig>(filepath);
-    case ModelType::HMM:         return fillConfig<HMMConfig>(filepath);
-    case ModelType::LCCRF:       return fillConfig<LCCRFConfig>(filepath);
-    case ModelType::IID:         return fillConfig<IIDConfig>(filepath);
-    case ModelType::VLMC:        return fillConfig<VLMCConfig>(filepath);
-    case ModelType::IMC:         return fillConfig<IMCConfig>(filepath);
-    case ModelType::PeriodicIMC: return fillConfig<PeriodicIMCConfig>(filepath);
-    case ModelType::SBSW:        return fillConfig<SBSWConfig>(filepath);
-    case ModelType::MSM:         return fillConfig<MSMConfig>(filepath);
-    case ModelType::MDD:         return fillConfig<MDDConfig>(filepath);
+    case ModelType::GHMM:
+      return fillConfig<GHMMConfig>(filepath, parser);
+    case ModelType::HMM:
+      return fillConfig<HMMConfig>(filepath, parser);
+    case ModelType::LCCRF:
+      return fillConfig<LCCRFConfig>(filepath, parser);
+    case ModelType::IID:
+      return fillConfig<IIDConfig>(filepath, parser);
+    case ModelType::VLMC:
+      return fillConfig<VLMCConfig>(filepath, parser);
+    case ModelType::IMC:
+      return fillConfig<IMCConfig>(filepath, parser);
+    case ModelType::PeriodicIMC:
+      return fillConfig<PeriodicIMCConfig>(filepath, parser);
+    case ModelType::SBSW:
+      return fillConfig<SBSWConfig>(filepath, parser);
+    case ModelType::MSM:
+      return fillConfig<MSMConfig>(filepath, parser);
+    case ModelType::MDD:
+      return fillConfig<MDDConfig>(filepath, parser);
   }
 }
 
 /*----------------------------------------------------------------------------*/
 
-Interpreter::ModelType Interpreter::findModelType(const std::string &filepath) {
-  auto root_dir = extractDir(filepath);
+config::ModelConfigPtr
+Interpreter::makeSubmodelConfig(const std::string &filepath) {
+  Tracer::Span span(tracer_, "model", filepath);
+
+  if (!lazy_) return makeModelConfig(filepath);
 
-  std::vector<std::string> modulepaths;
-  std::vector<std::string> usepaths { root_dir };
+  // The copy keeps the proxy valid after this interpreter is destroyed
+  auto interpreter = std::make_shared<Interpreter>(*this);
+  return config::LazyModelConfig::make(filepath, [interpreter, filepath] {
+    return interpreter->makeModelConfig(filepath);
+  });
+}
 
-  chaiscript::ChaiScript chai(modulepaths, usepaths);
-  chai.add(makeInterpreterLibrary(filepath));
+/*----------------------------------------------------------------------------*/
 
-  auto cfg = std::make_shared<config::ModelConfig>(filepath);
-  cfg->accept(ModelConfigRegister(chai));
+config::FeatureFunctionLibraryConfigPtr
+Interpreter::makeLibraryConfig(const std::string &filepath) {
+  // Libraries are files on their own, although they are never memoized
+  Tracer::Span span(tracer_, "file", filepath);
+  return fillConfig<config::FeatureFunctionLibraryConfig>(filepath);
+}
 
-  try {
-    chai.eval_file(filepath);
-  } catch (const std::exception &e) {
-    // Explicitly ignore missing object exceptions
-    if (!missingObjectException(e)) throw;
-  }
+/*----------------------------------------------------------------------------*/
 
-  auto model_name = std::get<decltype("model_type"_t)>(*cfg.get());
+Interpreter::ModelType Interpreter::findModelType(const std::string &filepath,
+                                                  DeclarativeParserPtr parser) {
+  Tracer::Span span(tracer_, "findModelType", filepath);
+
+  std::string model_name;
+
+  if (parser) {
+    model_name = parser->modelType();
+  } else {
+    auto root_dir = extractDir(filepath);
+
+    std::vector<std::string> modulepaths;
+    std::vector<std::string> usepaths { root_dir };
+
+    // Built apart so that construction is traced as a phase of its own
+    std::unique_ptr<chaiscript::ChaiScript> chai;
+    {
+      Tracer::Span engine_span(tracer_, "engine", filepath);
+      chai = std::make_unique<chaiscript::ChaiScript>(modulepaths, usepaths);
+      addLibraries(*chai, filepath);
+    }
+
+    auto cfg = std::make_shared<config::ModelConfig>(filepath);
+    {
+      Tracer::Span register_span(tracer_, "register", filepath);
+      cfg->accept(ModelConfigRegister(*chai));
+    }
+
+    try {
+      Tracer::Span eval_span(tracer_, "eval_file", filepath);
+      chai->eval_file(filepath);
+    } catch (const std::exception &e) {
+      // Explicitly ignore missing object exceptions
+      if (!missingObjectException(e)) throw;
+    }
+
+    model_name = std::get<decltype("model_type"_t)>(*cfg.get());
+  }
 
   try {
     return model_type_map.at(model_name);
@@ -237,53 +442,39 @@ bool Interpreter::missingObjectException(const std::exception &e) {
 
 /*----------------------------------------------------------------------------*/
 
-chaiscript::ModulePtr
-Interpreter::makeInterpreterLibrary(const std::string &filepath) {
-  static auto interpreter_library = std::make_shared<chaiscript::Module>();
-  static bool initialized = false;
-
-  if (!initialized) {
-    registerTypes(interpreter_library, filepath);
-    registerHelpers(interpreter_library, filepath);
-    registerConstants(interpreter_library, filepath);
-    registerAttributions(interpreter_library, filepath);
-    registerConcatenations(interpreter_library, filepath);
-    initialized = true;
+config::DependencyTreeConfigPtr Interpreter::makeDependencyTree(
+    const std::string &root_dir, const std::string &file) {
+  auto filepath = root_dir + file;
+  Tracer::Span span(tracer_, "tree", filepath);
+
+  std::ifstream src(filepath);
+
+  std::string line;
+  std::vector<std::string> content;
+  while (std::getline(src, line)) {
+    content.push_back(line);
   }
 
-  return interpreter_library;
+  DependencyTreeParser parser(this, root_dir, file, content);
+  return parser.parse();
 }
 
 /*----------------------------------------------------------------------------*/
 
-void Interpreter::registerTypes(chaiscript::ModulePtr &module,
-                                const std::string &/* filepath */) {
-  REGISTER_TYPE(Type);
-  REGISTER_TYPE(Alphabet);
-  REGISTER_TYPE(Alphabets);
-  REGISTER_TYPE(Size);
-  REGISTER_TYPE(Probabilities);
-  REGISTER_TYPE(Domain);
-  REGISTER_TYPE(Domains);
-  REGISTER_TYPE(Duration);
-  REGISTER_TYPE(Model);
-  REGISTER_TYPE(Models);
-  REGISTER_TYPE(State);
-  REGISTER_TYPE(States);
-  REGISTER_TYPE(DependencyTree);
-  REGISTER_TYPE(DependencyTrees);
-  REGISTER_TYPE(FeatureFunctions);
-  REGISTER_TYPE(FeatureFunctionLibraries);
+void Interpreter::addLibraries(chaiscript::ChaiScript &chai,
+                               const std::string &filepath) {
+  chai.add(library_);
+  chai.add(makeFileLibrary(filepath));
+}
 
-  REGISTER_VECTOR(Alphabet);
-  REGISTER_VECTOR(Alphabets);
-  REGISTER_VECTOR(Domains);
-  REGISTER_VECTOR(Models);
-  REGISTER_VECTOR(DependencyTrees);
-  REGISTER_VECTOR(FeatureFunctionLibraries);
+/*----------------------------------------------------------------------------*/
 
-  REGISTER_MAP(Probabilities);
-  REGISTER_MAP(States);
+chaiscript::ModulePtr
+Interpreter::makeFileLibrary(const std::string &filepath) {
+  auto file_library = std::make_shared<chaiscript::Module>();
+  registerHelpers(file_library, filepath);
+  registerFileAttributions(file_library, filepath);
+  return file_library;
 }
 
 /*----------------------------------------------------------------------------*/
@@ -301,7 +492,7 @@ void Interpreter::registerHelpers(chaiscript::ModulePtr &module,
 
   module->add(fun([this, filepath] (const std::string &file) {
     auto root_dir = extractDir(filepath);
-    return this->makeModelConfig(root_dir + file);
+    return this->makeSubmodelConfig(root_dir + file);
   }), "model");
 
   module->add(fun([this, filepath]() {
@@ -312,7 +503,7 @@ void Interpreter::registerHelpers(chaiscript::ModulePtr &module,
   module->add(fun([this, filepath] (const std::string &file) {
     auto duration_ptr = ExplicitDurationConfig::make(filepath, "explicit");
     std::get<decltype("model"_t)>(*duration_ptr.get())
-      = this->makeModelConfig(extractDir(filepath) + file);
+      = this->makeSubmodelConfig(extractDir(filepath) + file);
     return config::DurationConfigPtr(duration_ptr);
   }), "explicit");
 
@@ -321,7 +512,7 @@ void Interpreter::registerHelpers(chaiscript::ModulePtr &module,
     auto duration_ptr = ExplicitDurationConfig::make(filepath, "explicit");
     std::get<decltype("max_size"_t)>(*duration_ptr.get()) = size;
     std::get<decltype("model"_t)>(*duration_ptr.get())
-      = this->makeModelConfig(extractDir(filepath) + file);
+      = this->makeSubmodelConfig(extractDir(filepath) + file);
     return config::DurationConfigPtr(duration_ptr);
   }), "explicit");
 
@@ -347,40 +538,137 @@ void Interpreter::registerHelpers(chaiscript::ModulePtr &module,
 
   module->add(fun([this, filepath] (const std::string &file) {
     auto root_dir = extractDir(filepath);
-    return this->fillConfig<FeatureFunctionLibraryConfig>(root_dir + file);
+    return this->makeLibraryConfig(root_dir + file);
   }), "lib");
 
   module->add(fun([this, filepath] (const std::string &file) {
-    auto root_dir = extractDir(filepath);
-
-    std::ifstream src(root_dir + file);
-
-    std::string line;
-    std::vector<std::string> content;
-    while (std::getline(src, line)) {
-      content.push_back(line);
-    }
-
-    DependencyTreeParser parser(this, root_dir, file, content);
-    return parser.parse();
+    return this->makeDependencyTree(extractDir(filepath), file);
   }), "tree");
 
+  module->add(fun([this, filepath] (const std::string &file) {
+    auto table_path = extractDir(filepath) + file;
+    Tracer::Span span(tracer_, "table", table_path);
+    return TableFile(table_path).read();
+  }), "table");
+
   module->add(fun([this] (const config::option::Alphabet &alphabet) {
-    return std::make_shared<config::Domain>(
+    return config::makeShared<config::Domain>(
         typename config::Domain::discrete_domain{}, alphabet);
   }), "discrete_domain");
 
+  module->add(fun([this] (unsigned int min, unsigned int max) {
+    return config::makeShared<config::Domain>(
+        typename config::Domain::range_domain{}, min, max);
+  }), "range_domain");
+
   module->add(fun([this] (const config::option::OutToInSymbolFunction &o2i,
                           const config::option::InToOutSymbolFunction &i2o) {
-    return std::make_shared<config::Domain>(
+    return config::makeShared<config::Domain>(
         typename config::Domain::custom_domain{}, o2i, i2o);
   }), "custom_domain");
+
+  module->add(fun([this] (const config::option::OutToInSymbolFunction &o2i,
+                          const config::option::InToOutSymbolFunction &i2o,
+                          const config::option::Alphabet &alphabet) {
+    return config::makeShared<config::Domain>(
+        typename config::Domain::custom_domain{}, o2i, i2o, alphabet);
+  }), "custom_domain");
+
+  module->add(fun([this] (const config::option::OutToInSymbolFunction &o2i,
+                          const config::option::InToOutSymbolFunction &i2o,
+                          unsigned int max_cached) {
+    return config::makeShared<config::Domain>(
+        typename config::Domain::custom_domain{}, o2i, i2o,
+        std::size_t{max_cached});
+  }), "custom_domain");
 }
 
 /*----------------------------------------------------------------------------*/
 
-void Interpreter::registerConstants(chaiscript::ModulePtr &module,
-                                    const std::string &/* filepath */) {
+void Interpreter::registerFileAttributions(chaiscript::ModulePtr &module,
+                                           const std::string &filepath) {
+  using chaiscript::fun;
+  using chaiscript::boxed_cast;
+
+  using chaiscript::Boxed_Value;
+  using Map = std::map<std::string, Boxed_Value>;
+
+  // States are created with the path of the file defining them
+  module->add(fun([filepath] (config::option::States &conv, const Map &orig) {
+    for (auto &pair : orig) {
+      const auto &inner_orig = unbox<Map>(pair.second);
+
+      auto state = config::makeShared<config::StateConfig>(filepath);
+
+      std::get<decltype("duration"_t)>(*state)
+        = boxed_cast<config::DurationConfigPtr>(
+            findElement(inner_orig, "duration"));
+
+      std::get<decltype("emission"_t)>(*state)
+        = boxed_cast<config::ModelConfigPtr>(
+            findElement(inner_orig, "emission"));
+
+      conv[pair.first] = std::move(state);
+    }
+  }), "=");
+}
+
+/*----------------------------------------------------------------------------*/
+/*                               STATIC METHODS                               */
+/*----------------------------------------------------------------------------*/
+
+chaiscript::ModulePtr Interpreter::makeSharedLibrary() {
+  auto shared_library = std::make_shared<chaiscript::Module>();
+  registerTypes(shared_library);
+  registerConstants(shared_library);
+  registerAttributions(shared_library);
+  registerConcatenations(shared_library);
+  return shared_library;
+}
+
+/*----------------------------------------------------------------------------*/
+
+void Interpreter::registerTypes(chaiscript::ModulePtr &module) {
+  using chaiscript::type_conversion;
+  using config::option::Symbol;
+
+  REGISTER_TYPE(Type);
+  REGISTER_TYPE(Symbol);
+  REGISTER_TYPE(Alphabet);
+  REGISTER_TYPE(Alphabets);
+  REGISTER_TYPE(Size);
+  REGISTER_TYPE(Probabilities);
+  REGISTER_TYPE(Domain);
+  REGISTER_TYPE(Domains);
+  REGISTER_TYPE(Duration);
+  REGISTER_TYPE(Model);
+  REGISTER_TYPE(Models);
+  REGISTER_TYPE(State);
+  REGISTER_TYPE(States);
+  REGISTER_TYPE(DependencyTree);
+  REGISTER_TYPE(DependencyTrees);
+  REGISTER_TYPE(FeatureFunctions);
+  REGISTER_TYPE(FeatureFunctionLibraries);
+
+  REGISTER_VECTOR(Alphabet);
+  REGISTER_VECTOR(Alphabets);
+  REGISTER_VECTOR(Domains);
+  REGISTER_VECTOR(Models);
+  REGISTER_VECTOR(DependencyTrees);
+  REGISTER_VECTOR(FeatureFunctionLibraries);
+
+  REGISTER_MAP(States);
+
+  // Scripts only see strings, interned in the table of the current scope
+  module->add(type_conversion<std::string, Symbol>(
+    [] (const std::string &name) { return Symbol(name); }));
+  module->add(type_conversion<Symbol, std::string>(
+    [] (const Symbol &symbol) { return symbol.str(); }));
+}
+
+/*----------------------------------------------------------------------------*/
+
+void Interpreter::registerConstants(chaiscript::ModulePtr &module) {
   using chaiscript::const_var;
 
   module->add_global_const(const_var(std::string("emission")), "emission");
@@ -389,8 +677,7 @@ void Interpreter::registerConstants(chaiscript::ModulePtr &module,
 
 /*----------------------------------------------------------------------------*/
 
-void Interpreter::registerAttributions(chaiscript::ModulePtr &module,
-                                       const std::string &filepath) {
+void Interpreter::registerAttributions(chaiscript::ModulePtr &module) {
   using chaiscript::fun;
   using chaiscript::boxed_cast;
 
@@ -398,45 +685,34 @@ void Interpreter::registerAttributions(chaiscript::ModulePtr &module,
   using Vector = std::vector<Boxed_Value>;
   using Map = std::map<std::string, Boxed_Value>;
 
+  // Literals are converted in bulk, reading elements of the expected type
+  // directly instead of dispatching boxed_cast for each one of them
   module->add(fun([] (config::Domain &conv, const Vector &orig) {
-    config::option::Alphabet alphabet;
-    for (auto &element : orig)
-      alphabet.push_back(boxed_cast<config::option::Symbol>(element));
+    conv = config::Domain(typename config::Domain::discrete_domain{},
+                          makeAlphabet(orig));
+  }), "=");
 
-    conv = config::Domain(typename config::Domain::discrete_domain{}, alphabet);
+  module->add(fun([] (config::option::Alphabet &conv, const Vector &orig) {
+    conv = makeAlphabet(orig);
   }), "=");
 
   module->add(fun([] (config::option::Alphabets &conv, const Vector &orig) {
-    for (auto &element : orig) {
-      auto inner_orig = boxed_cast<Vector &>(element);
-      config::option::Alphabet inner_conv;
-
-      for (auto &inner_element : inner_orig)
-        inner_conv.push_back(boxed_cast<config::option::Symbol>(inner_element));
-
-      conv.push_back(inner_conv);
-    }
+    conv.reserve(conv.size() + orig.size());
+    for (auto &element : orig)
+      conv.push_back(makeAlphabet(unbox<Vector>(element)));
   }), "=");
 
-  module->add(fun([filepath] (config::option::States &conv, const Map &orig) {
-    for (auto &pair : orig) {
-      auto inner_orig = boxed_cast<Map &>(pair.second);
-
-      conv[pair.first] = std::make_shared<config::StateConfig>(filepath);
-
-      std::get<decltype("duration"_t)>(*conv[pair.first])
-        = boxed_cast<config::DurationConfigPtr>(inner_orig["duration"]);
-
-      std::get<decltype("emission"_t)>(*conv[pair.first])
-        = boxed_cast<config::ModelConfigPtr>(inner_orig["emission"]);
-    }
+  // Map literals only have string keys, so conditions are parsed back
+  module->add(fun([] (config::option::Probabilities &conv, const Map &orig) {
+    conv.reserve(conv.size() + orig.size());
+    for (auto &pair : orig)
+      conv[config::Condition::parse(pair.first)] = unboxNumber(pair.second);
   }), "=");
 }
 
 /*----------------------------------------------------------------------------*/
 
-void Interpreter::registerConcatenations(chaiscript::ModulePtr &module,
-                                         const std::string &/* filepath */) {
+void Interpreter::registerConcatenations(chaiscript::ModulePtr &module) {
   using chaiscript::fun;
 
   module->add(fun([] (const std::string &lhs, const std::string &rhs) {
@@ -0,0 +1,197 @@
+/***********************************************************************/
+/*  Copyright 2016 ToPS                                                */
+/*                                                                     */
+/*  This program is free software; you can redistribute it and/or      */
+/*  modify it under the terms of the GNU  General Public License as    */
+/*  published by the Free Software Foundation; either version 3 of     */
+/*  the License, or (at your option) any later version.                */
+/*                                                                     */
+/*  This program is distributed in the hope that it will be useful,    */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of     */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the      */
+/*  GNU General Public License for more details.                       */
+/*                                                                     */
+/*  You should have received a copy of the GNU General Public License  */
+/*  along with this program; if not, write to the Free Software        */
+/*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,         */
+/*  MA 02110-1301, USA.                                                */
+/***********************************************************************/
+
+// Interface header
+#include "lang/ModelConfigCache.hpp"
+
+// Standard headers
+#include <atomic>
+#include <cstdio>
+#include <string>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <exception>
+#include <stdexcept>
+
+// Internal headers
+#include "lang/Util.hpp"
+#include "lang/DependencyScanner.hpp"
+#include "lang/ModelConfigReader.hpp"
+#include "lang/ModelConfigWriter.hpp"
+
+#include "filesystem/Filesystem.hpp"
+
+// POSIX headers
+#include <unistd.h>  // getpid
+
+namespace lang {
+
+/*----------------------------------------------------------------------------*/
+/*                               LOCAL CONSTANTS                              */
+/*----------------------------------------------------------------------------*/
+
+// Changing the binary format must change this header
+static const std::string cache_magic = "tops-lang model cache v1\n";
+
+static const std::uint64_t fnv_offset_basis = 14695981039346656037ULL;
+static const std::uint64_t fnv_prime = 1099511628211ULL;
+
+/*----------------------------------------------------------------------------*/
+/*                               LOCAL VARIABLES                              */
+/*----------------------------------------------------------------------------*/
+
+static std::atomic<unsigned long> tmp_counter(0);
+
+/*----------------------------------------------------------------------------*/
+/*                               LOCAL FUNCTIONS                              */
+/*----------------------------------------------------------------------------*/
+
+static void combine(std::uint64_t &hash, const std::string &bytes) {
+  for (unsigned char byte : bytes) {
+    hash ^= byte;
+    hash *= fnv_prime;
+  }
+  // Separator, so that concatenations of different fields never collide
+  hash ^= 0xff;
+  hash *= fnv_prime;
+}
+
+/*----------------------------------------------------------------------------*/
+/*                                CONSTRUCTORS                                */
+/*----------------------------------------------------------------------------*/
+
+ModelConfigCache::ModelConfigCache(const std::string &cache_dir)
+    : cache_dir_(cache_dir) {
+  if (!cache_dir_.empty() && cache_dir_.back() != '/') cache_dir_ += '/';
+}
+
+/*----------------------------------------------------------------------------*/
+/*                              CONCRETE METHODS                              */
+/*----------------------------------------------------------------------------*/
+
+std::string ModelConfigCache::key(const std::string &filepath) const {
+  // Files may change between calls, so hashes are only shared within one,
+  // which also lets concurrent calls read files without locking
+  Hashing hashing;
+  auto model_hash = hash(filepath, extractDir(filepath), hashing);
+
+  // Files referenced through computed paths are not part of the hash
+  if (hashing.dynamic) return "";
+
+  char buffer[17];
+  std::snprintf(buffer, sizeof(buffer), "%016llx",
+                static_cast<unsigned long long>(model_hash));
+  return buffer;
+}
+
+/*----------------------------------------------------------------------------*/
+
+config::ModelConfigPtr ModelConfigCache::load(const std::string &key) {
+  std::ifstream src(pathForKey(key), std::ios::binary);
+  if (!src) return nullptr;
+
+  std::string magic(cache_magic.size(), '\0');
+  src.read(&magic[0], static_cast<std::streamsize>(magic.size()));
+  if (!src || magic != cache_magic) return nullptr;
+
+  try {
+    return ModelConfigReader(src).read();
+  } catch (const std::exception &/* e */) {
+    // Corrupted entries are treated as misses and overwritten later
+    return nullptr;
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigCache::store(const std::string &key,
+                             config::ModelConfigPtr model) {
+  auto path = pathForKey(key);
+
+  // Other threads and processes may be storing the same entry
+  auto tmp_path = path + "." + std::to_string(::getpid())
+                + "." + std::to_string(tmp_counter++) + ".tmp";
+
+  filesystem::create_directories(cache_dir_);
+
+  try {
+    std::ofstream dst(tmp_path, std::ios::binary | std::ios::trunc);
+    dst.write(cache_magic.data(),
+              static_cast<std::streamsize>(cache_magic.size()));
+    ModelConfigWriter(dst).write(model);
+    dst.close();
+    if (!dst) throw std::runtime_error("Could not write " + tmp_path);
+  } catch (const std::exception &/* e */) {
+    // Models with libraries or custom domains cannot be cached
+    std::remove(tmp_path.c_str());
+    return;
+  }
+
+  // Renaming is atomic, so readers never see partial entries
+  if (std::rename(tmp_path.c_str(), path.c_str()) != 0)
+    std::remove(tmp_path.c_str());
+}
+
+/*----------------------------------------------------------------------------*/
+
+std::uint64_t ModelConfigCache::hash(const std::string &filepath,
+                                     const std::string &root_dir,
+                                     Hashing &hashing) const {
+  auto id = filepath + '\n' + root_dir;
+
+  auto it = hashing.hashes.find(id);
+  if (it != hashing.hashes.end()) return it->second;
+
+  std::uint64_t hash = fnv_offset_basis;
+  combine(hash, cache_magic);
+  combine(hash, filepath);
+
+  std::ifstream src(filepath, std::ios::binary);
+  combine(hash, std::string(std::istreambuf_iterator<char>(src),
+                            std::istreambuf_iterator<char>()));
+
+  // Cyclic references contribute only with their path
+  if (!hashing.visiting.insert(id).second) return hash;
+
+  for (const auto &dependency : DependencyScanner().scan(filepath, root_dir)) {
+    if (dependency.dynamic) {
+      hashing.dynamic = true;
+      continue;
+    }
+
+    auto dependency_hash = this->hash(dependency.filepath,
+                                      dependency.root_dir, hashing);
+    combine(hash, std::string(reinterpret_cast<const char *>(&dependency_hash),
+                              sizeof(dependency_hash)));
+  }
+
+  hashing.visiting.erase(id);
+  return hashing.hashes[id] = hash;
+}
+
+/*----------------------------------------------------------------------------*/
+
+std::string ModelConfigCache::pathForKey(const std::string &key) const {
+  return cache_dir_ + key + ".bin";
+}
+
+/*----------------------------------------------------------------------------*/
+
+}  // namespace lang
@@ -0,0 +1,463 @@
+/***********************************************************************/
+/*  Copyright 2016 ToPS                                                */
+/*                                                                     */
+/*  This program is free software; you can redistribute it and/or      */
+/*  modify it under the terms of the GNU  General Public License as    */
+/*  published by the Free Software Foundation; either version 3 of     */
+/*  the License, or (at your option) any later version.                */
+/*                                                                     */
+/*  This program is distributed in the hope that it will be useful,    */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of     */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the      */
+/*  GNU General Public License for more details.                       */
+/*                                                                     */
+/*  You should have received a copy of the GNU General Public License  */
+/*  along with this program; if not, write to the Free Software        */
+/*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,         */
+/*  MA 02110-1301, USA.                                                */
+/***********************************************************************/
+
+// Interface header
+#include "lang/ModelConfigFiller.hpp"
+
+// Standard headers
+#include <limits>
+#include <memory>
+#include <string>
+#include <stdexcept>
+
+// Internal headers
+#include "lang/Util.hpp"
+#include "lang/TableFile.hpp"
+#include "lang/Interpreter.hpp"
+
+#include "config/Arena.hpp"
+#include "config/BasicConfig.hpp"
+#include "config/StringLiteralSuffix.hpp"
+
+#include "config/FixedDurationConfig.hpp"
+#include "config/ExplicitDurationConfig.hpp"
+#include "config/GeometricDurationConfig.hpp"
+#include "config/MaxLengthDurationConfig.hpp"
+
+// Using declarations
+using config::operator ""_t;
+
+namespace lang {
+
+/*----------------------------------------------------------------------------*/
+/*                                CONSTRUCTORS                                */
+/*----------------------------------------------------------------------------*/
+
+ModelConfigFiller::ModelConfigFiller(Interpreter *interpreter,
+                                     const DeclarativeParser &parser)
+    : interpreter_(interpreter), parser_(parser) {
+}
+
+/*----------------------------------------------------------------------------*/
+/*                             OVERRIDEN METHODS                              */
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigFiller::startVisit() {
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigFiller::endVisit() {
+  for (auto &statement : parser_.statements()) {
+    if (tags_.count(statement.first) == 0) {
+      throw std::logic_error(
+          parser_.filepath() + ": Unknown option " + statement.first);
+    }
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigFiller::visitOption(config::option::Model &visited) {
+  using element_type = typename config::option::Model::element_type;
+  auto value = current();
+  visited = value ? makeModel(*value) : config::makeShared<element_type>();
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigFiller::visitOption(config::option::State &visited) {
+  using element_type = typename config::option::State::element_type;
+  auto value = current();
+  visited = value ? makeState(*value) : config::makeShared<element_type>();
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigFiller::visitOption(config::option::Domain &visited) {
+  using element_type = typename config::option::Domain::element_type;
+  auto value = current();
+  visited = value ? makeDomain(*value) : config::makeShared<element_type>();
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigFiller::visitOption(config::option::Duration &visited) {
+  using element_type = typename config::option::Duration::element_type;
+  auto value = current();
+  visited = value ? makeDuration(*value) : config::makeShared<element_type>();
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigFiller::visitOption(
+    config::option::FeatureFunctionLibrary &visited) {
+  using element_type
+    = typename config::option::FeatureFunctionLibrary::element_type;
+  auto value = current();
+  visited = value ? makeLibrary(*value) : config::makeShared<element_type>();
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigFiller::visitOption(config::option::Models &visited) {
+  auto value = current();
+  if (!value) return;
+
+  if (value->kind != Value::Kind::List) invalid("expected a vector");
+  for (auto &element : value->values)
+    visited.push_back(makeModel(element));
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigFiller::visitOption(config::option::States &visited) {
+  auto value = current();
+  if (!value) return;
+
+  if (value->kind == Value::Kind::List && value->values.empty()) return;
+  if (value->kind != Value::Kind::Map) invalid("expected a map");
+
+  for (std::size_t i = 0; i < value->keys.size(); i++)
+    visited[value->keys[i].string()] = makeState(value->values[i]);
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigFiller::visitOption(config::option::Domains &visited) {
+  auto value = current();
+  if (!value) return;
+
+  if (value->kind != Value::Kind::List) invalid("expected a vector");
+  for (auto &element : value->values)
+    visited.push_back(makeDomain(element));
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigFiller::visitOption(
+    config::option::DependencyTrees &visited) {
+  auto value = current();
+  if (!value) return;
+
+  if (value->kind != Value::Kind::List) invalid("expected a vector");
+  for (auto &element : value->values)
+    visited.push_back(makeDependencyTree(element));
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigFiller::visitOption(
+    config::option::FeatureFunctionLibraries &visited) {
+  auto value = current();
+  if (!value) return;
+
+  if (value->kind != Value::Kind::List) invalid("expected a vector");
+  for (auto &element : value->values)
+    visited.push_back(makeLibrary(element));
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigFiller::visitOption(config::option::Type &visited) {
+  auto value = current();
+  if (value) visited = makeString(*value);
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigFiller::visitOption(config::option::Size &visited) {
+  auto value = current();
+  if (value) visited = makeSize(*value);
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigFiller::visitOption(config::option::Alphabet &visited) {
+  auto value = current();
+  if (value) visited = makeAlphabet(*value);
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigFiller::visitOption(config::option::Alphabets &visited) {
+  auto value = current();
+  if (!value) return;
+
+  if (value->kind != Value::Kind::List) invalid("expected a vector");
+  for (auto &element : value->values)
+    visited.push_back(makeAlphabet(element));
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigFiller::visitOption(config::option::Probability &visited) {
+  auto value = current();
+  if (value) visited = makeProbability(*value);
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigFiller::visitOption(config::option::Probabilities &visited) {
+  auto value = current();
+  if (!value) return;
+
+  if (value->kind == Value::Kind::List && value->values.empty()) return;
+
+  if (value->isCall("table") && value->values.size() == 1) {
+    auto table_path = extractDir(parser_.filepath())
+                      + makeString(value->values[0]);
+    Tracer::Span span(interpreter_->tracer_, "table", table_path);
+    TableFile(table_path).read(visited);
+    return;
+  }
+
+  if (value->kind != Value::Kind::Map) invalid("expected a map");
+
+  visited.reserve(visited.size() + value->keys.size());
+  for (std::size_t i = 0; i < value->keys.size(); i++)
+    visited[makeCondition(value->keys[i])] = makeProbability(value->values[i]);
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigFiller::visitOption(config::option::DependencyTree &visited) {
+  auto value = current();
+  if (value) visited = makeDependencyTree(*value);
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigFiller::visitOption(
+    config::option::FeatureFunctions &/* visited */) {
+  if (current()) invalid("functions must be defined with ChaiScript");
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigFiller::visitOption(
+    config::option::OutToInSymbolFunction &/* visited */) {
+  if (current()) invalid("functions must be defined with ChaiScript");
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigFiller::visitOption(
+    config::option::InToOutSymbolFunction &/* visited */) {
+  if (current()) invalid("functions must be defined with ChaiScript");
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigFiller::visitTag(
+    const std::string &tag, std::size_t /* count */, std::size_t /* max */) {
+  tag_ = tag;
+  tags_.insert(tag);
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigFiller::visitLabel(const std::string &/* label */) {
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigFiller::visitPath(const std::string &/* path */) {
+}
+
+/*----------------------------------------------------------------------------*/
+/*                              CONCRETE METHODS                              */
+/*----------------------------------------------------------------------------*/
+
+const ModelConfigFiller::Value *ModelConfigFiller::current() {
+  return parser_.find(tag_);
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigFiller::invalid(const std::string &reason) {
+  throw std::logic_error(
+      parser_.filepath() + ": Invalid value for " + tag_ + ", " + reason);
+}
+
+/*----------------------------------------------------------------------------*/
+
+std::string ModelConfigFiller::makeString(const Value &value) {
+  if (!value.isString()) invalid("expected a string");
+  return value.string();
+}
+
+/*----------------------------------------------------------------------------*/
+
+unsigned int ModelConfigFiller::makeSize(const Value &value) {
+  if (value.kind != Value::Kind::Integer) invalid("expected an integer");
+  if (value.integer < 0
+  ||  value.integer > std::numeric_limits<unsigned int>::max())
+    invalid("expected a size between 0 and "
+            + std::to_string(std::numeric_limits<unsigned int>::max()));
+  return static_cast<unsigned int>(value.integer);
+}
+
+/*----------------------------------------------------------------------------*/
+
+config::Condition ModelConfigFiller::makeCondition(const Value &value) {
+  if (value.isCondition()) {
+    const auto &target = value.values[0];
+    const auto &context = value.values[1];
+    return config::Condition(target.data, target.size,
+                             context.data, context.size);
+  }
+
+  if (!value.isString()) invalid("expected a condition");
+  return config::Condition::parse(value.string());
+}
+
+/*----------------------------------------------------------------------------*/
+
+double ModelConfigFiller::makeProbability(const Value &value) {
+  if (!value.isNumber()) invalid("expected a number");
+  return value.number();
+}
+
+/*----------------------------------------------------------------------------*/
+
+config::option::Alphabet ModelConfigFiller::makeAlphabet(const Value &value) {
+  if (value.kind != Value::Kind::List) invalid("expected a vector");
+
+  config::option::Alphabet alphabet;
+  alphabet.reserve(value.values.size());
+  for (auto &element : value.values)
+    alphabet.push_back(makeString(element));
+  return alphabet;
+}
+
+/*----------------------------------------------------------------------------*/
+
+config::ModelConfigPtr ModelConfigFiller::makeModel(const Value &value) {
+  if (!value.isCall("model") || value.values.size() != 1)
+    invalid("expected model(file)");
+
+  auto root_dir = extractDir(parser_.filepath());
+  return interpreter_->makeSubmodelConfig(
+      root_dir + makeString(value.values[0]));
+}
+
+/*----------------------------------------------------------------------------*/
+
+config::StateConfigPtr ModelConfigFiller::makeState(const Value &value) {
+  if (value.kind != Value::Kind::Map) invalid("expected a map");
+
+  const Value *duration = nullptr, *emission = nullptr;
+  for (std::size_t i = 0; i < value.keys.size(); i++) {
+    if (value.keys[i].string() == "duration") duration = &value.values[i];
+    if (value.keys[i].string() == "emission") emission = &value.values[i];
+  }
+
+  if (!duration || !emission) invalid("expected duration and emission");
+
+  auto state_ptr = config::makeShared<config::StateConfig>(parser_.filepath());
+  std::get<decltype("duration"_t)>(*state_ptr) = makeDuration(*duration);
+  std::get<decltype("emission"_t)>(*state_ptr) = makeModel(*emission);
+  return state_ptr;
+}
+
+/*----------------------------------------------------------------------------*/
+
+config::DomainPtr ModelConfigFiller::makeDomain(const Value &value) {
+  if (value.isCall("discrete_domain") && value.values.size() == 1)
+    return makeDomain(value.values[0]);
+
+  if (value.isCall("range_domain") && value.values.size() == 2) {
+    return config::makeShared<config::Domain>(
+        typename config::Domain::range_domain{},
+        makeSize(value.values[0]), makeSize(value.values[1]));
+  }
+
+  return config::makeShared<config::Domain>(
+      typename config::Domain::discrete_domain{}, makeAlphabet(value));
+}
+
+/*----------------------------------------------------------------------------*/
+
+config::DurationConfigPtr ModelConfigFiller::makeDuration(const Value &value) {
+  using config::FixedDurationConfig;
+  using config::ExplicitDurationConfig;
+  using config::GeometricDurationConfig;
+  using config::MaxLengthDurationConfig;
+
+  auto &filepath = parser_.filepath();
+  auto &args = value.values;
+
+  if (value.isCall("geometric") && args.empty()) {
+    return GeometricDurationConfig::make(filepath, "geometric");
+  }
+
+  if (value.isCall("explicit") && (args.size() == 1 || args.size() == 2)) {
+    auto duration_ptr = ExplicitDurationConfig::make(filepath, "explicit");
+    if (args.size() == 2)
+      std::get<decltype("max_size"_t)>(*duration_ptr) = makeSize(args[1]);
+    std::get<decltype("model"_t)>(*duration_ptr) = args[0].isString()
+      ? interpreter_->makeSubmodelConfig(
+            extractDir(filepath) + args[0].string())
+      : makeModel(args[0]);
+    return duration_ptr;
+  }
+
+  if (value.isCall("fixed") && args.size() == 1) {
+    auto duration_ptr = FixedDurationConfig::make(filepath, "fixed");
+    std::get<decltype("size"_t)>(*duration_ptr) = makeSize(args[0]);
+    return duration_ptr;
+  }
+
+  if (value.isCall("max_length") && args.size() == 1) {
+    auto duration_ptr = MaxLengthDurationConfig::make(filepath, "max_length");
+    std::get<decltype("size"_t)>(*duration_ptr) = makeSize(args[0]);
+    return duration_ptr;
+  }
+
+  invalid("expected a duration");
+}
+
+/*----------------------------------------------------------------------------*/
+
+config::DependencyTreeConfigPtr
+ModelConfigFiller::makeDependencyTree(const Value &value) {
+  if (!value.isCall("tree") || value.values.size() != 1)
+    invalid("expected tree(file)");
+
+  auto root_dir = extractDir(parser_.filepath());
+  return interpreter_->makeDependencyTree(
+      root_dir, makeString(value.values[0]));
+}
+
+/*----------------------------------------------------------------------------*/
+
+config::FeatureFunctionLibraryConfigPtr
+ModelConfigFiller::makeLibrary(const Value &value) {
+  if (!value.isCall("lib") || value.values.size() != 1)
+    invalid("expected lib(file)");
+
+  auto root_dir = extractDir(parser_.filepath());
+  return interpreter_->makeLibraryConfig(
+      root_dir + makeString(value.values[0]));
+}
+
+/*----------------------------------------------------------------------------*/
+
+}  // namespace lang
@@ -0,0 +1,445 @@
+/***********************************************************************/
+/*  Copyright 2016 ToPS                                                */
+/*                                                                     */
+/*  This program is free software; you can redistribute it and/or      */
+/*  modify it under the terms of the GNU  General Public License as    */
+/*  published by the Free Software Foundation; either version 3 of     */
+/*  the License, or (at your option) any later version.                */
+/*                                                                     */
+/*  This program is distributed in the hope that it will be useful,    */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of     */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the      */
+/*  GNU General Public License for more details.                       */
+/*                                                                     */
+/*  You should have received a copy of the GNU General Public License  */
+/*  along with this program; if not, write to the Free Software        */
+/*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,         */
+/*  MA 02110-1301, USA.                                                */
+/***********************************************************************/
+
+// Interface header
+#include "lang/ModelConfigProfiler.hpp"
+
+// Standard headers
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstddef>
+#include <ostream>
+#include <utility>
+#include <algorithm>
+
+// Internal headers
+#include "config/BasicConfig.hpp"
+#include "config/LazyModelConfig.hpp"
+
+namespace lang {
+
+/*----------------------------------------------------------------------------*/
+/*                               LOCAL CONSTANTS                              */
+/*----------------------------------------------------------------------------*/
+
+// Reference counts and deleter of objects created with std::make_shared
+static const std::size_t control_block_size
+  = sizeof(void *) + 2 * sizeof(int);
+
+// Header of a config, without the options (accounted one by one)
+static const std::size_t config_size
+  = sizeof(config::BasicConfigInterface)
+  + sizeof(std::vector<std::shared_ptr<config::BasicConfigInterface>>);
+
+// Pointers and color of a node of std::map
+static const std::size_t map_node_overhead = 4 * sizeof(void *);
+
+/*----------------------------------------------------------------------------*/
+/*                               LOCAL FUNCTIONS                              */
+/*----------------------------------------------------------------------------*/
+
+static void reportRows(std::ostream &os, const std::string &title,
+                       const std::map<std::string,
+                                      ModelConfigProfiler::Footprint> &rows,
+                       std::size_t max_rows) {
+  using Row = std::pair<std::string, ModelConfigProfiler::Footprint>;
+
+  std::vector<Row> sorted(rows.begin(), rows.end());
+  std::sort(sorted.begin(), sorted.end(), [] (const Row &lhs, const Row &rhs) {
+    return lhs.second.bytes > rhs.second.bytes;
+  });
+  if (sorted.size() > max_rows) sorted.resize(max_rows);
+
+  char line[64];
+  os << std::endl << "      bytes   objects  " << title << std::endl;
+  for (const auto &row : sorted) {
+    std::snprintf(line, sizeof(line), "%11zu %9zu  ",
+                  row.second.bytes, row.second.objects);
+    os << line << (row.first.empty() ? "-" : row.first) << std::endl;
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+/*                             OVERRIDEN METHODS                              */
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigProfiler::startVisit() {
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigProfiler::endVisit() {
+  frames_.pop_back();
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigProfiler::visitOption(config::option::Model &visited) {
+  accountInline(visited);
+
+  // Proxies not loaded yet only hold their loader
+  auto lazy_ptr = std::dynamic_pointer_cast<config::LazyModelConfig>(visited);
+  if (!lazy_ptr) {
+    visitShared(visited, config_size, [this, &visited] {
+      visited->accept(*this);
+    });
+    return;
+  }
+
+  visitShared(visited, sizeof(config::LazyModelConfig), [this, &lazy_ptr] {
+    if (!lazy_ptr->loaded()) return;
+
+    auto model_ptr = lazy_ptr->model();
+    visitOption(model_ptr);
+  });
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigProfiler::visitOption(config::option::State &visited) {
+  accountInline(visited);
+  visitShared(visited, config_size, [this, &visited] {
+    visited->accept(*this);
+  });
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigProfiler::visitOption(config::option::Domain &visited) {
+  accountInline(visited);
+  visitShared(visited, sizeof(config::Domain), [this, &visited] {
+    auto data = visited->data();
+    visitShared(data, config_size, [this, &data] {
+      data->accept(*this);
+    });
+  });
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigProfiler::visitOption(config::option::Duration &visited) {
+  accountInline(visited);
+  visitShared(visited, config_size, [this, &visited] {
+    visited->accept(*this);
+  });
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigProfiler::visitOption(
+    config::option::DependencyTree &visited) {
+  accountInline(visited);
+  visitShared(visited, config_size, [this, &visited] {
+    visited->accept(*this);
+
+    // Children are counted as if they were an option of their parent
+    auto &children = visited->children();
+    account("vectors", (children.capacity() - children.size())
+                       * sizeof(config::option::DependencyTree));
+    for (auto &child : children)
+      visitOption(child);
+  });
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigProfiler::visitOption(
+    config::option::FeatureFunctionLibrary &visited) {
+  accountInline(visited);
+  visitShared(visited, config_size, [this, &visited] {
+    visited->accept(*this);
+  });
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigProfiler::visitOption(config::option::Models &visited) {
+  accountVector(visited);
+  for (auto &model : visited)
+    visitOption(model);
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigProfiler::visitOption(config::option::States &visited) {
+  accountInline(visited);
+  for (auto &state : visited) {
+    account("map nodes", map_node_overhead + sizeof(state.first));
+    visitOption(state.second);
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigProfiler::visitOption(config::option::Domains &visited) {
+  accountVector(visited);
+  for (auto &domain : visited)
+    visitOption(domain);
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigProfiler::visitOption(
+    config::option::DependencyTrees &visited) {
+  accountVector(visited);
+  for (auto &tree : visited)
+    visitOption(tree);
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigProfiler::visitOption(
+    config::option::FeatureFunctionLibraries &visited) {
+  accountVector(visited);
+  for (auto &library : visited)
+    visitOption(library);
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigProfiler::visitOption(config::option::Type &visited) {
+  accountInline(visited);
+  accountString(visited);
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigProfiler::visitOption(config::option::Size &visited) {
+  accountInline(visited);
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigProfiler::visitOption(config::option::Alphabet &visited) {
+  accountInline(visited);
+  account("vectors", visited.capacity() * sizeof(config::option::Symbol));
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigProfiler::visitOption(config::option::Alphabets &visited) {
+  accountVector(visited);
+  for (auto &alphabet : visited)
+    visitOption(alphabet);
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigProfiler::visitOption(config::option::Probability &visited) {
+  accountInline(visited);
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigProfiler::visitOption(
+    config::option::Probabilities &visited) {
+  using Entry = config::option::Probabilities::value_type;
+
+  accountInline(visited);
+  if (visited.capacity() == 0) return;
+
+  account("probability entries", visited.capacity() * sizeof(Entry));
+  account("probability index",
+          visited.bucket_count() * sizeof(std::uint32_t));
+
+  for (auto &pair : visited) {
+    account("condition keys",
+            pair.first.capacity() * sizeof(config::Condition::Symbol));
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigProfiler::visitOption(
+    config::option::FeatureFunctions &visited) {
+  accountInline(visited);
+  for (auto &pair : visited) {
+    account("map nodes", map_node_overhead + sizeof(pair.first));
+    accountString(pair.first);
+    account("functions", sizeof(pair.second));
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigProfiler::visitOption(
+    config::option::OutToInSymbolFunction &visited) {
+  account("functions", sizeof(visited));
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigProfiler::visitOption(
+    config::option::InToOutSymbolFunction &visited) {
+  account("functions", sizeof(visited));
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigProfiler::visitTag(const std::string &tag,
+                                   std::size_t /* count */,
+                                   std::size_t /* max */) {
+  frames_.back().tag = tag;
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigProfiler::visitLabel(const std::string &/* label */) {
+  // Headers are attributed to the option referencing the config
+  frames_.push_back(frames_.empty() ? Frame() : frames_.back());
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigProfiler::visitPath(const std::string &path) {
+  // Configs without path (like domains) belong to the enclosing file
+  if (!path.empty()) frames_.back().path = path;
+}
+
+/*----------------------------------------------------------------------------*/
+/*                              CONCRETE METHODS                              */
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigProfiler::profile(config::ModelConfigPtr model_ptr) {
+  frames_.push_back({ model_ptr ? model_ptr->path() : "", "" });
+  visitOption(model_ptr);
+  frames_.pop_back();
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigProfiler::report(std::ostream &os,
+                                 std::size_t max_rows) const {
+  os << "Total: " << total_.bytes << " bytes in "
+     << total_.objects << " objects" << std::endl
+     << "Shared: " << shared_.objects << " repeated references to "
+     << shared_.bytes << " bytes counted once" << std::endl;
+
+  reportRows(os, "kind", kinds_, max_rows);
+  reportRows(os, "tag", tags_, max_rows);
+  reportRows(os, "file", files_, max_rows);
+}
+
+/*----------------------------------------------------------------------------*/
+
+const ModelConfigProfiler::Footprint &ModelConfigProfiler::total() const {
+  return total_;
+}
+
+/*----------------------------------------------------------------------------*/
+
+const ModelConfigProfiler::Footprint &ModelConfigProfiler::shared() const {
+  return shared_;
+}
+
+/*----------------------------------------------------------------------------*/
+
+const std::map<std::string, ModelConfigProfiler::Footprint> &
+ModelConfigProfiler::byFile() const {
+  return files_;
+}
+
+/*----------------------------------------------------------------------------*/
+
+const std::map<std::string, ModelConfigProfiler::Footprint> &
+ModelConfigProfiler::byTag() const {
+  return tags_;
+}
+
+/*----------------------------------------------------------------------------*/
+
+const std::map<std::string, ModelConfigProfiler::Footprint> &
+ModelConfigProfiler::byKind() const {
+  return kinds_;
+}
+
+/*----------------------------------------------------------------------------*/
+
+template<typename Visited, typename Func>
+void ModelConfigProfiler::visitShared(const Visited &visited,
+                                      std::size_t size, Func &&func) {
+  if (!visited) return;
+
+  auto it = visited_.find(visited.get());
+  if (it != visited_.end()) {
+    shared_.bytes += it->second;
+    shared_.objects++;
+    return;
+  }
+  visited_.emplace(visited.get(), 0);
+
+  auto bytes_before = total_.bytes;
+
+  account("configs", size);
+  account("control blocks", control_block_size);
+  func();
+
+  visited_[visited.get()] = total_.bytes - bytes_before;
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigProfiler::account(const char *kind,
+                                  std::size_t bytes, std::size_t objects) {
+  auto add = [bytes, objects] (Footprint &footprint) {
+    footprint.bytes += bytes;
+    footprint.objects += objects;
+  };
+
+  add(total_);
+  add(kinds_[kind]);
+  add(files_[frames_.back().path]);
+  add(tags_[frames_.back().tag]);
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigProfiler::accountString(const std::string &string) {
+  // Short strings are stored inside the object itself
+  auto data = reinterpret_cast<const char *>(string.data());
+  auto self = reinterpret_cast<const char *>(&string);
+  if (data >= self && data < self + sizeof(string)) return;
+
+  account("strings", string.capacity() + 1);
+}
+
+/*----------------------------------------------------------------------------*/
+
+template<typename T>
+void ModelConfigProfiler::accountVector(const std::vector<T> &vector) {
+  accountInline(vector);
+
+  // Elements in use are counted when visited
+  account("vectors", (vector.capacity() - vector.size()) * sizeof(T),
+          vector.capacity() > 0);
+}
+
+/*----------------------------------------------------------------------------*/
+
+template<typename Visited>
+void ModelConfigProfiler::accountInline(const Visited &/* visited */) {
+  account("inline", sizeof(Visited), 0);
+}
+
+/*----------------------------------------------------------------------------*/
+
+}  // namespace lang
@@ -0,0 +1,366 @@
+/***********************************************************************/
+/*  Copyright 2016 ToPS                                                */
+/*                                                                     */
+/*  This program is free software; you can redistribute it and/or      */
+/*  modify it under the terms of the GNU  General Public License as    */
+/*  published by the Free Software Foundation; either version 3 of     */
+/*  the License, or (at your option) any later version.                */
+/*                                                                     */
+/*  This program is distributed in the hope that it will be useful,    */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of     */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the      */
+/*  GNU General Public License for more details.                       */
+/*                                                                     */
+/*  You should have received a copy of the GNU General Public License  */
+/*  along with this program; if not, write to the Free Software        */
+/*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,         */
+/*  MA 02110-1301, USA.                                                */
+/***********************************************************************/
+
+// Interface header
+#include "lang/ModelConfigReader.hpp"
+
+// Standard headers
+#include <memory>
+#include <string>
+#include <cstdint>
+#include <istream>
+#include <stdexcept>
+
+// Internal headers
+#include "config/Arena.hpp"
+#include "config/BasicConfig.hpp"
+#include "config/StringLiteralSuffix.hpp"
+
+#include "config/HMMConfig.hpp"
+#include "config/IIDConfig.hpp"
+#include "config/IMCConfig.hpp"
+#include "config/MDDConfig.hpp"
+#include "config/MSMConfig.hpp"
+#include "config/GHMMConfig.hpp"
+#include "config/SBSWConfig.hpp"
+#include "config/VLMCConfig.hpp"
+#include "config/LCCRFConfig.hpp"
+#include "config/PeriodicIMCConfig.hpp"
+
+#include "config/FixedDurationConfig.hpp"
+#include "config/ExplicitDurationConfig.hpp"
+#include "config/GeometricDurationConfig.hpp"
+#include "config/MaxLengthDurationConfig.hpp"
+
+// Using declarations
+using config::operator ""_t;
+
+namespace lang {
+
+/*----------------------------------------------------------------------------*/
+/*                                CONSTRUCTORS                                */
+/*----------------------------------------------------------------------------*/
+
+ModelConfigReader::ModelConfigReader(std::istream &is) : is_(is) {
+}
+
+/*----------------------------------------------------------------------------*/
+/*                             OVERRIDEN METHODS                              */
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigReader::startVisit() {
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigReader::endVisit() {
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigReader::visitOption(config::option::Model &visited) {
+  visited = nullptr;
+  if (!readInteger()) return;
+
+  auto type = readString();
+  auto path = readString();
+  auto label = readString();
+
+  visited = makeModel(type, path, label);
+  visited->accept(*this);
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigReader::visitOption(config::option::State &visited) {
+  visited = nullptr;
+  if (!readInteger()) return;
+
+  auto path = readString();
+  auto label = readString();
+
+  visited = config::StateConfig::make(path, label);
+  visited->accept(*this);
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigReader::visitOption(config::option::Domain &visited) {
+  visited = nullptr;
+  if (!readInteger()) return;
+
+  auto label = readString();
+  if (label.empty()) {
+    visited = config::makeShared<config::Domain>();
+  } else if (label == "discrete_domain") {
+    config::option::Alphabet alphabet;
+    visitOption(alphabet);
+    visited = config::makeShared<config::Domain>(
+        typename config::Domain::discrete_domain{}, alphabet);
+  } else if (label == "range_domain") {
+    config::option::Size min, max;
+    visitOption(min);
+    visitOption(max);
+    visited = config::makeShared<config::Domain>(
+        typename config::Domain::range_domain{}, min, max);
+  } else {
+    throw std::runtime_error("Unknown domain " + label);
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigReader::visitOption(config::option::Duration &visited) {
+  visited = nullptr;
+  if (!readInteger()) return;
+
+  auto path = readString();
+  auto label = readString();
+
+  visited = makeDuration(path, label);
+  visited->accept(*this);
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigReader::visitOption(config::option::DependencyTree &visited) {
+  visited = nullptr;
+  if (!readInteger()) return;
+
+  auto path = readString();
+  auto label = readString();
+
+  visited = config::DependencyTreeConfig::make(path, label);
+  visited->accept(*this);
+
+  visited->children().resize(readInteger());
+  for (auto &child : visited->children())
+    visitOption(child);
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigReader::visitOption(
+    config::option::FeatureFunctionLibrary &visited) {
+  visited = nullptr;
+  if (readInteger())
+    throw std::runtime_error("Feature function libraries cannot be read");
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigReader::visitOption(config::option::Models &visited) {
+  visited.resize(readInteger());
+  for (auto &model : visited)
+    visitOption(model);
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigReader::visitOption(config::option::States &visited) {
+  auto size = readInteger();
+  for (std::uint64_t i = 0; i < size; i++) {
+    auto name = readString();
+    visitOption(visited[name]);
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigReader::visitOption(config::option::Domains &visited) {
+  visited.resize(readInteger());
+  for (auto &domain : visited)
+    visitOption(domain);
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigReader::visitOption(config::option::DependencyTrees &visited) {
+  visited.resize(readInteger());
+  for (auto &tree : visited)
+    visitOption(tree);
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigReader::visitOption(
+    config::option::FeatureFunctionLibraries &visited) {
+  visited.resize(readInteger());
+  for (auto &library : visited)
+    visitOption(library);
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigReader::visitOption(config::option::Type &visited) {
+  visited = readString();
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigReader::visitOption(config::option::Size &visited) {
+  visited = static_cast<config::option::Size>(readInteger());
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigReader::visitOption(config::option::Alphabet &visited) {
+  visited.resize(readInteger());
+  for (auto &symbol : visited)
+    symbol = readString();
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigReader::visitOption(config::option::Alphabets &visited) {
+  visited.resize(readInteger());
+  for (auto &alphabet : visited)
+    visitOption(alphabet);
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigReader::visitOption(config::option::Probability &visited) {
+  visited = readReal();
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigReader::visitOption(config::option::Probabilities &visited) {
+  auto size = readInteger();
+  visited.reserve(visited.size() + static_cast<std::size_t>(size));
+  for (std::uint64_t i = 0; i < size; i++) {
+    auto key = config::Condition::parse(readString());
+    visited.emplace(key, readReal());
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigReader::visitOption(
+    config::option::FeatureFunctions &/* visited */) {
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigReader::visitOption(
+    config::option::OutToInSymbolFunction &/* visited */) {
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigReader::visitOption(
+    config::option::InToOutSymbolFunction &/* visited */) {
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigReader::visitTag(const std::string &/* tag */,
+                                 std::size_t /* count */,
+                                 std::size_t /* max */) {
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigReader::visitLabel(const std::string &/* label */) {
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigReader::visitPath(const std::string &/* path */) {
+}
+
+/*----------------------------------------------------------------------------*/
+/*                              CONCRETE METHODS                              */
+/*----------------------------------------------------------------------------*/
+
+config::ModelConfigPtr ModelConfigReader::read() {
+  config::ModelConfigPtr model_ptr;
+  visitOption(model_ptr);
+  return model_ptr;
+}
+
+/*----------------------------------------------------------------------------*/
+
+std::string ModelConfigReader::readString() {
+  std::string string(readInteger(), '\0');
+  is_.read(&string[0], static_cast<std::streamsize>(string.size()));
+  if (!is_) throw std::runtime_error("Unexpected end of model");
+  return string;
+}
+
+/*----------------------------------------------------------------------------*/
+
+std::uint64_t ModelConfigReader::readInteger() {
+  std::uint64_t integer = 0;
+  is_.read(reinterpret_cast<char *>(&integer), sizeof(integer));
+  if (!is_) throw std::runtime_error("Unexpected end of model");
+  return integer;
+}
+
+/*----------------------------------------------------------------------------*/
+
+double ModelConfigReader::readReal() {
+  double real = 0;
+  is_.read(reinterpret_cast<char *>(&real), sizeof(real));
+  if (!is_) throw std::runtime_error("Unexpected end of model");
+  return real;
+}
+
+/*----------------------------------------------------------------------------*/
+
+config::ModelConfigPtr ModelConfigReader::makeModel(const std::string &type,
+                                                    const std::string &path,
+                                                    const std::string &label) {
+  using namespace config;  // NOLINT(build/namespaces)
+
+  if (type == "GHMM")        return GHMMConfig::make(path, label);
+  if (type == "HMM")         return HMMConfig::make(path, label);
+  if (type == "LCCRF")       return LCCRFConfig::make(path, label);
+  if (type == "IID")         return IIDConfig::make(path, label);
+  if (type == "VLMC")        return VLMCConfig::make(path, label);
+  if (type == "IMC")         return IMCConfig::make(path, label);
+  if (type == "PeriodicIMC") return PeriodicIMCConfig::make(path, label);
+  if (type == "SBSW")        return SBSWConfig::make(path, label);
+  if (type == "MSM")         return MSMConfig::make(path, label);
+  if (type == "MDD")         return MDDConfig::make(path, label);
+  if (type.empty())          return ModelConfig::make(path, label);
+
+  throw std::runtime_error("Unknown model type " + type);
+}
+
+/*----------------------------------------------------------------------------*/
+
+config::DurationConfigPtr
+ModelConfigReader::makeDuration(const std::string &path,
+                                const std::string &label) {
+  using namespace config;  // NOLINT(build/namespaces)
+
+  if (label == "geometric")  return GeometricDurationConfig::make(path, label);
+  if (label == "explicit")   return ExplicitDurationConfig::make(path, label);
+  if (label == "fixed")      return FixedDurationConfig::make(path, label);
+  if (label == "max_length") return MaxLengthDurationConfig::make(path, label);
+  if (label.empty())         return DurationConfig::make(path, label);
+
+  throw std::runtime_error("Unknown duration " + label);
+}
+
+/*----------------------------------------------------------------------------*/
+
+}  // namespace lang
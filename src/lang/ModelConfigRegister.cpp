@@ -25,6 +25,7 @@
 #include <string>
 
 // Internal headers
+#include "config/Arena.hpp"
 #include "config/Options.hpp"
 #include "config/ModelConfig.hpp"
 #include "config/StateConfig.hpp"
@@ -64,7 +65,7 @@ void ModelConfigRegister::endVisit() {
 
 void ModelConfigRegister::visitOption(config::option::Model &visited) {
   using element_type = typename config::option::Model::element_type;
-  visited = std::make_shared<element_type>();
+  visited = config::makeShared<element_type>();
   chai_.add(chaiscript::var(visited), tag_);
 }
 
@@ -72,7 +73,7 @@ void ModelConfigRegister::visitOption(config::option::Model &visited) {
 
 void ModelConfigRegister::visitOption(config::option::State &visited) {
   using element_type = typename config::option::State::element_type;
-  visited = std::make_shared<element_type>();
+  visited = config::makeShared<element_type>();
   chai_.add(chaiscript::var(visited), tag_);
 }
 
@@ -80,7 +81,7 @@ void ModelConfigRegister::visitOption(config::option::State &visited) {
 
 void ModelConfigRegister::visitOption(config::option::Domain &visited) {
   using element_type = typename config::option::Domain::element_type;
-  visited = std::make_shared<element_type>();
+  visited = config::makeShared<element_type>();
   chai_.add(chaiscript::var(visited), tag_);
 }
 
@@ -88,7 +89,7 @@ void ModelConfigRegister::visitOption(config::option::Domain &visited) {
 
 void ModelConfigRegister::visitOption(config::option::Duration &visited) {
   using element_type = typename config::option::Duration::element_type;
-  visited = std::make_shared<element_type>();
+  visited = config::makeShared<element_type>();
   chai_.add(chaiscript::var(visited), tag_);
 }
 
@@ -98,7 +99,7 @@ void ModelConfigRegister::visitOption(
     config::option::FeatureFunctionLibrary &visited) {
   using element_type
     = typename config::option::FeatureFunctionLibrary::element_type;
-  visited = std::make_shared<element_type>();
+  visited = config::makeShared<element_type>();
   chai_.add(chaiscript::var(visited), tag_);
 }
 
@@ -0,0 +1,286 @@
+/***********************************************************************/
+/*  Copyright 2016 ToPS                                                */
+/*                                                                     */
+/*  This program is free software; you can redistribute it and/or      */
+/*  modify it under the terms of the GNU  General Public License as    */
+/*  published by the Free Software Foundation; either version 3 of     */
+/*  the License, or (at your option) any later version.                */
+/*                                                                     */
+/*  This program is distributed in the hope that it will be useful,    */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of     */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the      */
+/*  GNU General Public License for more details.                       */
+/*                                                                     */
+/*  You should have received a copy of the GNU General Public License  */
+/*  along with this program; if not, write to the Free Software        */
+/*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,         */
+/*  MA 02110-1301, USA.                                                */
+/***********************************************************************/
+
+// Interface header
+#include "lang/ModelConfigWriter.hpp"
+
+// Standard headers
+#include <string>
+#include <cstdint>
+#include <ostream>
+#include <stdexcept>
+
+// Internal headers
+#include "config/BasicConfig.hpp"
+#include "config/LazyModelConfig.hpp"
+#include "config/StringLiteralSuffix.hpp"
+
+// Using declarations
+using config::operator ""_t;
+
+namespace lang {
+
+/*----------------------------------------------------------------------------*/
+/*                                CONSTRUCTORS                                */
+/*----------------------------------------------------------------------------*/
+
+ModelConfigWriter::ModelConfigWriter(std::ostream &os) : os_(os) {
+}
+
+/*----------------------------------------------------------------------------*/
+/*                             OVERRIDEN METHODS                              */
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigWriter::startVisit() {
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigWriter::endVisit() {
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigWriter::visitOption(config::option::Model &visited) {
+  writeInteger(visited != nullptr);
+  if (!visited) return;
+
+  // Lazy proxies only know their model type after being loaded
+  auto model_ptr = config::LazyModelConfig::resolve(visited);
+
+  writeString(std::get<decltype("model_type"_t)>(*model_ptr));
+  writeString(model_ptr->path());
+  writeString(model_ptr->label());
+  model_ptr->accept(*this);
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigWriter::visitOption(config::option::State &visited) {
+  writeInteger(visited != nullptr);
+  if (!visited) return;
+
+  writeString(visited->path());
+  writeString(visited->label());
+  visited->accept(*this);
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigWriter::visitOption(config::option::Domain &visited) {
+  writeInteger(visited != nullptr);
+  if (!visited) return;
+
+  auto data = visited->data();
+  writeString(data ? data->label() : "");
+  if (data) data->accept(*this);
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigWriter::visitOption(config::option::Duration &visited) {
+  writeInteger(visited != nullptr);
+  if (!visited) return;
+
+  writeString(visited->path());
+  writeString(visited->label());
+  visited->accept(*this);
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigWriter::visitOption(config::option::DependencyTree &visited) {
+  writeInteger(visited != nullptr);
+  if (!visited) return;
+
+  writeString(visited->path());
+  writeString(visited->label());
+  visited->accept(*this);
+
+  writeInteger(visited->children().size());
+  for (auto &child : visited->children())
+    visitOption(child);
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigWriter::visitOption(
+    config::option::FeatureFunctionLibrary &visited) {
+  writeInteger(visited != nullptr);
+  if (visited)
+    throw std::logic_error("Feature function libraries cannot be written");
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigWriter::visitOption(config::option::Models &visited) {
+  writeInteger(visited.size());
+  for (auto &model : visited)
+    visitOption(model);
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigWriter::visitOption(config::option::States &visited) {
+  writeInteger(visited.size());
+  for (auto &state : visited) {
+    writeString(state.first);
+    visitOption(state.second);
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigWriter::visitOption(config::option::Domains &visited) {
+  writeInteger(visited.size());
+  for (auto &domain : visited)
+    visitOption(domain);
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigWriter::visitOption(config::option::DependencyTrees &visited) {
+  writeInteger(visited.size());
+  for (auto &tree : visited)
+    visitOption(tree);
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigWriter::visitOption(
+    config::option::FeatureFunctionLibraries &visited) {
+  writeInteger(visited.size());
+  for (auto &library : visited)
+    visitOption(library);
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigWriter::visitOption(config::option::Type &visited) {
+  writeString(visited);
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigWriter::visitOption(config::option::Size &visited) {
+  writeInteger(visited);
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigWriter::visitOption(config::option::Alphabet &visited) {
+  writeInteger(visited.size());
+  for (auto &symbol : visited)
+    writeString(symbol);
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigWriter::visitOption(config::option::Alphabets &visited) {
+  writeInteger(visited.size());
+  for (auto &alphabet : visited)
+    visitOption(alphabet);
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigWriter::visitOption(config::option::Probability &visited) {
+  writeReal(visited);
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigWriter::visitOption(config::option::Probabilities &visited) {
+  writeInteger(visited.size());
+  for (auto &pair : visited) {
+    writeString(pair.first.str());
+    writeReal(pair.second);
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigWriter::visitOption(config::option::FeatureFunctions &visited) {
+  if (!visited.empty())
+    throw std::logic_error("Feature functions cannot be written");
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigWriter::visitOption(
+    config::option::OutToInSymbolFunction &visited) {
+  if (visited)
+    throw std::logic_error("Custom domains cannot be written");
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigWriter::visitOption(
+    config::option::InToOutSymbolFunction &visited) {
+  if (visited)
+    throw std::logic_error("Custom domains cannot be written");
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigWriter::visitTag(const std::string &/* tag */,
+                                 std::size_t /* count */,
+                                 std::size_t /* max */) {
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigWriter::visitLabel(const std::string &/* label */) {
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigWriter::visitPath(const std::string &/* path */) {
+}
+
+/*----------------------------------------------------------------------------*/
+/*                              CONCRETE METHODS                              */
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigWriter::write(config::ModelConfigPtr model_ptr) {
+  visitOption(model_ptr);
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigWriter::writeString(const std::string &string) {
+  writeInteger(string.size());
+  os_.write(string.data(), static_cast<std::streamsize>(string.size()));
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigWriter::writeInteger(std::uint64_t integer) {
+  os_.write(reinterpret_cast<const char *>(&integer), sizeof(integer));
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelConfigWriter::writeReal(double real) {
+  os_.write(reinterpret_cast<const char *>(&real), sizeof(real));
+}
+
+/*----------------------------------------------------------------------------*/
+
+}  // namespace lang
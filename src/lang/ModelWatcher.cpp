@@ -0,0 +1,204 @@
+/***********************************************************************/
+/*  Copyright 2016 ToPS                                                */
+/*                                                                     */
+/*  This program is free software; you can redistribute it and/or      */
+/*  modify it under the terms of the GNU  General Public License as    */
+/*  published by the Free Software Foundation; either version 3 of     */
+/*  the License, or (at your option) any later version.                */
+/*                                                                     */
+/*  This program is distributed in the hope that it will be useful,    */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of     */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the      */
+/*  GNU General Public License for more details.                       */
+/*                                                                     */
+/*  You should have received a copy of the GNU General Public License  */
+/*  along with this program; if not, write to the Free Software        */
+/*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,         */
+/*  MA 02110-1301, USA.                                                */
+/***********************************************************************/
+
+// Interface header
+#include "lang/ModelWatcher.hpp"
+
+// Standard headers
+#include <map>
+#include <set>
+#include <deque>
+#include <mutex>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <system_error>
+
+// Internal headers
+#include "lang/Util.hpp"
+
+#include "config/SymbolTable.hpp"
+
+// POSIX headers
+#include <poll.h>         // poll
+#include <errno.h>        // errno
+#include <unistd.h>       // read, close
+#include <sys/inotify.h>  // inotify_init1, inotify_add_watch
+
+namespace lang {
+
+/*----------------------------------------------------------------------------*/
+/*                               LOCAL CONSTANTS                              */
+/*----------------------------------------------------------------------------*/
+
+// Editors either rewrite files in place or rename a new copy over them
+static const std::uint32_t watched_events = IN_CLOSE_WRITE | IN_MOVED_TO;
+
+/*----------------------------------------------------------------------------*/
+/*                                CONSTRUCTORS                                */
+/*----------------------------------------------------------------------------*/
+
+ModelWatcher::ModelWatcher(const std::string &filepath)
+    : filepath_(filepath), fd_(inotify_init1(IN_CLOEXEC)) {
+  if (fd_ < 0) throw std::system_error(errno, std::system_category());
+
+  interpreter_.models_ = std::make_shared<Interpreter::ModelMemo>();
+
+  try {
+    reload({});
+  } catch (...) {
+    close(fd_);
+    throw;
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+/*                                 DESTRUCTOR                                 */
+/*----------------------------------------------------------------------------*/
+
+ModelWatcher::~ModelWatcher() {
+  close(fd_);
+}
+
+/*----------------------------------------------------------------------------*/
+/*                              CONCRETE METHODS                              */
+/*----------------------------------------------------------------------------*/
+
+config::ModelConfigPtr ModelWatcher::model() const {
+  return std::atomic_load(&model_);
+}
+
+/*----------------------------------------------------------------------------*/
+
+std::vector<std::string> ModelWatcher::update(int timeout_ms) {
+  std::set<std::string> changed_files;
+  bool reload_all = false;
+
+  alignas(struct inotify_event) char buffer[4096];
+
+  struct pollfd pfd { fd_, POLLIN, 0 };
+  while (poll(&pfd, 1, timeout_ms) > 0) {
+    auto length = read(fd_, buffer, sizeof(buffer));
+    if (length <= 0) break;
+
+    for (char *ptr = buffer; ptr < buffer + length; ) {
+      auto event = reinterpret_cast<struct inotify_event *>(ptr);
+      ptr += sizeof(struct inotify_event) + event->len;
+
+      // The kernel dropped events, so any file may have changed
+      if (event->mask & IN_Q_OVERFLOW) reload_all = true;
+      if (event->len == 0) continue;
+
+      // Files behind dynamic references are not in the graph, so any
+      // other file of a watched directory may be one of them
+      auto file = watched_dirs_[event->wd] + event->name;
+      if (graph_.dependencies.count(file) != 0)
+        changed_files.insert(file);
+      else if (!graph_.dynamic.empty())
+        reload_all = true;
+    }
+
+    // Saving several files at once generates a burst of events
+    timeout_ms = 0;
+  }
+
+  if (reload_all)
+    changed_files.insert(graph_.files.begin(), graph_.files.end());
+
+  if (!changed_files.empty()) reload(changed_files);
+
+  return { changed_files.begin(), changed_files.end() };
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelWatcher::reload(const std::set<std::string> &changed_files) {
+  graph_ = DependencyScanner().scanGraph(filepath_);
+  watch();
+
+  std::map<std::string, std::vector<std::string>> dependents;
+  for (const auto &node : graph_.dependencies)
+    for (const auto &dependency : node.second)
+      dependents[dependency].push_back(node.first);
+
+  // Lazy submodels may still be evaluated by other threads meanwhile
+  std::unique_lock<std::mutex> lock(interpreter_.models_->mutex);
+
+  // Changed files and all their ancestors must be evaluated again
+  auto &models = interpreter_.models_->models;
+  std::set<std::string> visited(changed_files);
+  std::deque<std::string> outdated(changed_files.begin(), changed_files.end());
+  while (!outdated.empty()) {
+    auto file = outdated.front();
+    outdated.pop_front();
+    models.erase(file);
+    for (const auto &dependent : dependents[file])
+      if (visited.insert(dependent).second) outdated.push_back(dependent);
+  }
+
+  // Files no longer referenced by the model are forgotten
+  for (auto it = models.begin(); it != models.end(); ) {
+    if (graph_.dependencies.count(it->first) == 0) it = models.erase(it);
+    else
+      it++;
+  }
+
+  lock.unlock();
+
+  // Strings of outdated models are freed with the last of their nodes,
+  // instead of piling up in a single table for the life of the watcher;
+  // lazy submodels still being evaluated may be reading the old table
+  std::atomic_store(&interpreter_.symbols_,
+                    std::make_shared<config::SymbolTable>());
+
+  // If the evaluation fails, readers keep seeing the previous model
+  std::atomic_store(&model_, interpreter_.evalModel(filepath_));
+
+  // Only now the files behind dynamic references are known
+  if (!graph_.dynamic.empty()) watch();
+}
+
+/*----------------------------------------------------------------------------*/
+
+void ModelWatcher::watch() {
+  std::set<std::string> dirs;
+  for (const auto &watched_dir : watched_dirs_)
+    dirs.insert(watched_dir.second);
+
+  std::vector<std::string> files(graph_.files);
+  {
+    std::lock_guard<std::mutex> lock(interpreter_.models_->mutex);
+    for (const auto &model : interpreter_.models_->models)
+      files.push_back(model.first);
+  }
+
+  for (const auto &file : files) {
+    auto dir = extractDir(file);
+    if (!dirs.insert(dir).second) continue;
+
+    auto wd = inotify_add_watch(fd_, dir.empty() ? "." : dir.c_str(),
+                                watched_events);
+    if (wd >= 0) watched_dirs_[wd] = dir;
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+
+}  // namespace lang
@@ -29,6 +29,8 @@
 
 // Internal headers
 #include "lang/Util.hpp"
+#include "lang/TableFile.hpp"
+#include "lang/OutputBuffer.hpp"
 #include "lang/ModelConfigSerializer.hpp"
 
 #include "config/BasicConfig.hpp"
@@ -37,15 +39,79 @@
 
 namespace lang {
 
+/*----------------------------------------------------------------------------*/
+/*                               LOCAL CONSTANTS                              */
+/*----------------------------------------------------------------------------*/
+
+// Smaller tables are more readable inside the file of their model
+static const std::size_t min_table_size = 1024;
+
 /*----------------------------------------------------------------------------*/
 /*                                CONSTRUCTORS                                */
 /*----------------------------------------------------------------------------*/
 
 MultipleFilePrinter::MultipleFilePrinter(const std::string &root_dir)
-  : Base(nullptr, 0), change_ostream_(true),
+  : Base(nullptr, 0), change_ostream_(true), root_printer_(true),
+    context_(std::make_shared<Context>()),
     root_dir_(cleanPath(root_dir + "/")) {
 }
 
+/*----------------------------------------------------------------------------*/
+
+MultipleFilePrinter::MultipleFilePrinter(const std::string &root_dir,
+                                         std::size_t num_threads)
+    : MultipleFilePrinter(root_dir) {
+  pool_ = std::make_unique<concurrency::ThreadPool>(num_threads);
+  context_->pool = pool_.get();
+}
+
+/*----------------------------------------------------------------------------*/
+/*                               INNER STRUCTS                                */
+/*----------------------------------------------------------------------------*/
+
+bool MultipleFilePrinter::Context::claim(const void *config,
+                                         const std::string &path) {
+  std::lock_guard<std::mutex> lock(mutex);
+
+  // The same config object (or another object evaluated from the same
+  // file) is written only the first time it is found
+  bool new_config = visited_configs.insert(config).second;
+  if (new_config && written_paths.emplace(path, 0).second)
+    return true;
+
+  avoided_paths[path]++;
+  return false;
+}
+
+/*----------------------------------------------------------------------------*/
+
+void MultipleFilePrinter::Context::record(const std::string &path,
+                                          std::size_t bytes) {
+  std::lock_guard<std::mutex> lock(mutex);
+  written_paths[path] = bytes;
+}
+
+/*----------------------------------------------------------------------------*/
+
+MultipleFilePrinter::Statistics
+MultipleFilePrinter::Context::statistics() const {
+  std::lock_guard<std::mutex> lock(mutex);
+
+  Statistics statistics;
+  for (auto &written : written_paths) {
+    statistics.files_written++;
+    statistics.bytes_written += written.second;
+  }
+  for (auto &avoided : avoided_paths) {
+    statistics.files_avoided += avoided.second;
+
+    auto written = written_paths.find(avoided.first);
+    if (written != written_paths.end())
+      statistics.bytes_avoided += avoided.second * written->second;
+  }
+  return statistics;
+}
+
 /*----------------------------------------------------------------------------*/
 /*                             OVERRIDEN METHODS                              */
 /*----------------------------------------------------------------------------*/
@@ -53,10 +119,25 @@ MultipleFilePrinter::MultipleFilePrinter(const std::string &root_dir)
 void MultipleFilePrinter::changeOstream(const std::string &path) {
   working_dir_ = extractDir(extractCorename(path));
   if (change_ostream_) {
-    auto new_path = root_dir_ + extractCorename(path);
-    filesystem::create_directories(extractDir(new_path));
-    os_ = std::make_shared<std::ofstream>(new_path);
+    output_path_ = pathForOutput(path);
+    filesystem::create_directories(extractDir(output_path_));
+    os_ = std::make_shared<OutputBuffer>(
+      std::make_shared<std::ofstream>(output_path_));
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+
+void MultipleFilePrinter::print(
+    const config::option::Probabilities &probabilities) {
+  if (!change_ostream_ || probabilities.size() < min_table_size) {
+    Base::print(probabilities);
+    return;
   }
+
+  auto path = pathForTable(tag_);
+  context_->record(path, TableFile(path).write(probabilities));
+  callFunction("table", '"' + extractBasename(path) + '"');
 }
 
 /*----------------------------------------------------------------------------*/
@@ -65,9 +146,9 @@ void MultipleFilePrinter::startPrinting() {
   Base::startPrinting();
 
   if (change_ostream_) {
-    *os_ << "// -*- mode: c++ -*-" << std::endl
-         << "// vim: ft=chaiscript:" << std::endl
-         << std::endl;
+    *os_ << "// -*- mode: c++ -*-\n"
+         << "// vim: ft=chaiscript:\n"
+         << "\n";
   }
 }
 
@@ -76,12 +157,27 @@ void MultipleFilePrinter::startPrinting() {
 void MultipleFilePrinter::endPrinting() {
   Base::endPrinting();
 
+  // The file of this printer is complete
+  if (change_ostream_) {
+    os_->flush();
+    context_->record(output_path_, os_->bytes());
+  }
+
   for (auto &submodel : submodels_)
     printSubmodel(submodel);
   for (auto &library : libraries_)
     printLibrary(library);
-  for (auto &tree : trees_)
-    printTree(tree);
+
+  for (auto &tree : trees_) {
+    if (!context_->claim(tree.get(), pathForOutput(tree->path()))) continue;
+    TreeState state;
+    printTree(tree, state);
+    context_->record(output_path_, os_->bytes());
+  }
+
+  // Only the printer created by the user waits for the files of submodels
+  if (root_printer_ && context_->pool)
+    context_->pool->wait();
 }
 
 /*----------------------------------------------------------------------------*/
@@ -96,7 +192,7 @@ void MultipleFilePrinter::print(config::ModelConfigPtr config_ptr) {
 void MultipleFilePrinter::print(config::StateConfigPtr state_ptr) {
   openSection('[');
   state_ptr->accept(ModelConfigSerializer(
-        Self::make(false, root_dir_, os_, depth_, ": ", ",\n")));
+        Self::make(false, root_dir_, context_, os_, depth_, ": ", ",\n")));
   closeSection(']');
 }
 
@@ -105,7 +201,7 @@ void MultipleFilePrinter::print(config::StateConfigPtr state_ptr) {
 void MultipleFilePrinter::print(config::DurationConfigPtr duration_ptr) {
   openFunction(duration_ptr->label());
   duration_ptr->accept(ModelConfigSerializer(
-        Self::make(false, root_dir_, os_, depth_, "", ", ", "")));
+        Self::make(false, root_dir_, context_, os_, depth_, "", ", ", "")));
   closeFunction();
 }
 
@@ -128,30 +224,78 @@ void MultipleFilePrinter::print(config::DependencyTreeConfigPtr tree_ptr) {
 /*                              CONCRETE METHODS                              */
 /*----------------------------------------------------------------------------*/
 
+MultipleFilePrinter::Statistics MultipleFilePrinter::statistics() const {
+  return context_->statistics();
+}
+
+/*----------------------------------------------------------------------------*/
+
 std::string MultipleFilePrinter::pathForHelperCall(const std::string &path) {
   return '"' + removeSubstring(working_dir_, extractCorename(path)) + '"';
 }
 
 /*----------------------------------------------------------------------------*/
 
+std::string MultipleFilePrinter::pathForOutput(const std::string &path) {
+  return root_dir_ + extractCorename(path);
+}
+
+/*----------------------------------------------------------------------------*/
+
+std::string MultipleFilePrinter::pathForTable(const std::string &tag) {
+  auto found = output_path_.find_last_of("./\\");
+  if (found != std::string::npos && output_path_[found] == '.')
+    return output_path_.substr(0, found) + "." + tag + ".tsv";
+  return output_path_ + "." + tag + ".tsv";
+}
+
+/*----------------------------------------------------------------------------*/
+
+void MultipleFilePrinter::schedule(std::function<void()> task) {
+  if (context_->pool)
+    context_->pool->enqueue(std::move(task));
+  else
+    task();
+}
+
+/*----------------------------------------------------------------------------*/
+
 void MultipleFilePrinter::printSubmodel(config::ModelConfigPtr submodel_ptr) {
-  submodel_ptr->accept(ModelConfigSerializer(
-        Self::make(true, root_dir_, os_, 0)));
+  auto path = pathForOutput(submodel_ptr->path());
+  if (!context_->claim(submodel_ptr.get(), path)) return;
+
+  // Tasks may outlive this printer, so they only capture shared state
+  auto root_dir = root_dir_;
+  auto context = context_;
+  schedule([submodel_ptr, root_dir, context] {
+    submodel_ptr->accept(ModelConfigSerializer(
+          Self::make(true, root_dir, context, nullptr, 0)));
+  });
 }
 
 /*----------------------------------------------------------------------------*/
 
 void MultipleFilePrinter::printLibrary(
     config::FeatureFunctionLibraryConfigPtr library_ptr) {
-  copy(library_ptr, std::make_shared<std::ofstream>(
-        root_dir_ + extractCorename(library_ptr->path())));
+  auto path = pathForOutput(library_ptr->path());
+  if (!context_->claim(library_ptr.get(), path)) return;
+
+  auto depth = depth_;
+  auto context = context_;
+  schedule([library_ptr, path, depth, context] {
+    OutputBuffer dst(std::make_shared<std::ofstream>(path));
+    copy(library_ptr, dst, depth);
+    dst.flush();
+    context->record(path, dst.bytes());
+  });
 }
 
 /*----------------------------------------------------------------------------*/
 
-void MultipleFilePrinter::printTree(config::DependencyTreeConfigPtr tree_ptr) {
-  thread_local unsigned int tree_depth = 0;
-  thread_local std::vector<unsigned int> tree_nodes { 1 };
+void MultipleFilePrinter::printTree(config::DependencyTreeConfigPtr tree_ptr,
+                                    TreeState &state) {
+  auto &tree_depth = state.depth;
+  auto &tree_nodes = state.nodes;
 
   if (tree_depth == 0)
     changeOstream(tree_ptr->path());
@@ -182,13 +326,13 @@ void MultipleFilePrinter::printTree(config::DependencyTreeConfigPtr tree_ptr) {
     tree_nodes.pop_back();
 
   tree_ptr->accept(ModelConfigSerializer(
-          Self::make(false, root_dir_, os_, depth_,
+          Self::make(false, root_dir_, context_, os_, depth_,
                      "", " ", "\n", "(", ")")));
 
   tree_depth++;
 
   for (auto& child : tree_ptr->children())
-    printTree(child);
+    printTree(child, state);
 
   tree_depth--;
 }
@@ -198,7 +342,7 @@ void MultipleFilePrinter::printTree(config::DependencyTreeConfigPtr tree_ptr) {
 void MultipleFilePrinter::print(config::DomainPtr domain_ptr) {
   openFunction(domain_ptr->data()->label());
   domain_ptr->data()->accept(ModelConfigSerializer(
-        Self::make(false, root_dir_, os_, depth_, "", ", ", "")));
+        Self::make(false, root_dir_, context_, os_, depth_, "", ", ", "")));
   closeFunction();
 }
 
@@ -0,0 +1,186 @@
+/***********************************************************************/
+/*  Copyright 2016 ToPS                                                */
+/*                                                                     */
+/*  This program is free software; you can redistribute it and/or      */
+/*  modify it under the terms of the GNU  General Public License as    */
+/*  published by the Free Software Foundation; either version 3 of     */
+/*  the License, or (at your option) any later version.                */
+/*                                                                     */
+/*  This program is distributed in the hope that it will be useful,    */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of     */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the      */
+/*  GNU General Public License for more details.                       */
+/*                                                                     */
+/*  You should have received a copy of the GNU General Public License  */
+/*  along with this program; if not, write to the Free Software        */
+/*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,         */
+/*  MA 02110-1301, USA.                                                */
+/***********************************************************************/
+
+// Interface header
+#include "lang/OutputBuffer.hpp"
+
+// Standard headers
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <utility>
+
+namespace lang {
+
+/*----------------------------------------------------------------------------*/
+/*                              LOCAL CONSTANTS                               */
+/*----------------------------------------------------------------------------*/
+
+// Bytes accumulated before handing a block to the stream
+static const std::size_t block_size = 1 << 20;
+
+/*----------------------------------------------------------------------------*/
+/*                              LOCAL FUNCTIONS                               */
+/*----------------------------------------------------------------------------*/
+
+static char *formatUnsigned(std::uint64_t num, char *end) {
+  do {
+    *--end = static_cast<char>('0' + num % 10);
+    num /= 10;
+  } while (num != 0);
+  return end;
+}
+
+/*----------------------------------------------------------------------------*/
+/*                                CONSTRUCTORS                                */
+/*----------------------------------------------------------------------------*/
+
+OutputBuffer::OutputBuffer(std::shared_ptr<std::ostream> os)
+    : os_(std::move(os)), bytes_(0) {
+}
+
+/*----------------------------------------------------------------------------*/
+/*                              CONCRETE METHODS                              */
+/*----------------------------------------------------------------------------*/
+
+OutputBuffer &OutputBuffer::operator<<(const std::string &string) {
+  append(string.data(), string.size());
+  return *this;
+}
+
+/*----------------------------------------------------------------------------*/
+
+OutputBuffer &OutputBuffer::operator<<(const char *string) {
+  append(string, std::strlen(string));
+  return *this;
+}
+
+/*----------------------------------------------------------------------------*/
+
+OutputBuffer &OutputBuffer::operator<<(char c) {
+  append(&c, 1);
+  return *this;
+}
+
+/*----------------------------------------------------------------------------*/
+
+OutputBuffer &OutputBuffer::operator<<(unsigned int num) {
+  char digits[24];
+  char *end = digits + sizeof(digits);
+  char *begin = formatUnsigned(num, end);
+  append(begin, end - begin);
+  return *this;
+}
+
+/*----------------------------------------------------------------------------*/
+
+OutputBuffer &OutputBuffer::operator<<(double num) {
+  // Same output of std::fixed with the default precision (%.6f). Values
+  // whose scaled fraction is far from a rounding tie are formatted here;
+  // the others, and large or non-finite values, go through snprintf.
+  double scaled = std::fabs(num) * 1e6;
+
+  if (std::isfinite(num) && scaled < 1e9) {
+    double integral = std::floor(scaled);
+    double fraction = scaled - integral;
+
+    if (std::fabs(fraction - 0.5) > 1e-6) {
+      auto value = static_cast<std::uint64_t>(integral) + (fraction > 0.5);
+
+      char digits[32];
+      char *end = digits + sizeof(digits);
+      char *begin = end - 6;
+
+      auto decimals = value % 1000000;
+      for (char *it = end; it != begin; decimals /= 10)
+        *--it = static_cast<char>('0' + decimals % 10);
+
+      *--begin = '.';
+      begin = formatUnsigned(value / 1000000, begin);
+      if (std::signbit(num)) *--begin = '-';
+
+      append(begin, end - begin);
+      return *this;
+    }
+  }
+
+  char digits[512];
+  int size = std::snprintf(digits, sizeof(digits), "%.6f", num);
+  append(digits, size);
+  return *this;
+}
+
+/*----------------------------------------------------------------------------*/
+
+OutputBuffer &OutputBuffer::operator<<(bool boolean) {
+  return *this << (boolean ? "true" : "false");
+}
+
+/*----------------------------------------------------------------------------*/
+
+void OutputBuffer::append(const char *data, std::size_t size) {
+  buffer_.append(data, size);
+  bytes_ += size;
+  if (buffer_.size() >= block_size) write();
+}
+
+/*----------------------------------------------------------------------------*/
+
+void OutputBuffer::appendSpaces(std::size_t count) {
+  buffer_.append(count, ' ');
+  bytes_ += count;
+  if (buffer_.size() >= block_size) write();
+}
+
+/*----------------------------------------------------------------------------*/
+
+void OutputBuffer::flush() {
+  write();
+  if (os_) os_->flush();
+}
+
+/*----------------------------------------------------------------------------*/
+
+std::size_t OutputBuffer::bytes() const {
+  return bytes_;
+}
+
+/*----------------------------------------------------------------------------*/
+
+void OutputBuffer::write() {
+  if (os_ && !buffer_.empty())
+    os_->write(buffer_.data(), buffer_.size());
+  buffer_.clear();
+}
+
+/*----------------------------------------------------------------------------*/
+/*                                 DESTRUCTOR                                 */
+/*----------------------------------------------------------------------------*/
+
+OutputBuffer::~OutputBuffer() {
+  flush();
+}
+
+/*----------------------------------------------------------------------------*/
+
+}  // namespace lang
@@ -25,6 +25,7 @@
 #include <algorithm>
 
 // Internal headers
+#include "lang/OutputBuffer.hpp"
 #include "lang/ModelConfigSerializer.hpp"
 
 #include "config/BasicConfig.hpp"
@@ -36,7 +37,7 @@ namespace lang {
 /*----------------------------------------------------------------------------*/
 
 SingleFilePrinter::SingleFilePrinter(std::shared_ptr<std::ostream> os)
-  : Base(os, 0) {
+  : Base(std::make_shared<OutputBuffer>(os), 0) {
 }
 
 /*----------------------------------------------------------------------------*/
@@ -73,14 +74,14 @@ void SingleFilePrinter::print(config::DurationConfigPtr duration_ptr) {
 void SingleFilePrinter::print(
     config::FeatureFunctionLibraryConfigPtr library_ptr) {
   openSection('{');
-  copy(library_ptr, os_);
+  copy(library_ptr, *os_, depth_);
   closeSection('}');
 }
 
 /*----------------------------------------------------------------------------*/
 
 void SingleFilePrinter::print(config::DependencyTreeConfigPtr tree_ptr) {
-  thread_local unsigned int depth_tree = 0;
+  auto &depth_tree = tree_depth_;
 
   if (depth_tree == 0)
     openFunction("tree");
@@ -0,0 +1,221 @@
+/***********************************************************************/
+/*  Copyright 2016 ToPS                                                */
+/*                                                                     */
+/*  This program is free software; you can redistribute it and/or      */
+/*  modify it under the terms of the GNU  General Public License as    */
+/*  published by the Free Software Foundation; either version 3 of     */
+/*  the License, or (at your option) any later version.                */
+/*                                                                     */
+/*  This program is distributed in the hope that it will be useful,    */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of     */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the      */
+/*  GNU General Public License for more details.                       */
+/*                                                                     */
+/*  You should have received a copy of the GNU General Public License  */
+/*  along with this program; if not, write to the Free Software        */
+/*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,         */
+/*  MA 02110-1301, USA.                                                */
+/***********************************************************************/
+
+// Interface header
+#include "lang/TableFile.hpp"
+
+// Standard headers
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <algorithm>
+#include <stdexcept>
+#include <system_error>
+
+// Internal headers
+#include "lang/OutputBuffer.hpp"
+
+#include "config/Condition.hpp"
+
+// POSIX headers
+#include <errno.h>     // errno
+#include <fcntl.h>     // open
+#include <unistd.h>    // close
+#include <sys/mman.h>  // mmap, munmap, madvise
+#include <sys/stat.h>  // fstat
+
+namespace lang {
+
+/*----------------------------------------------------------------------------*/
+/*                               LOCAL CONSTANTS                              */
+/*----------------------------------------------------------------------------*/
+
+static const char separator[] = " | ";
+
+/*----------------------------------------------------------------------------*/
+/*                                LOCAL STRUCTS                               */
+/*----------------------------------------------------------------------------*/
+
+struct MappedFile {
+  const char *data = nullptr;
+  std::size_t size = 0;
+
+  explicit MappedFile(const std::string &filepath) {
+    int fd = open(filepath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+      throw std::system_error(errno, std::system_category(), filepath);
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+      int error = errno;
+      close(fd);
+      throw std::system_error(error, std::system_category(), filepath);
+    }
+
+    size = static_cast<std::size_t>(info.st_size);
+    if (size == 0) {
+      close(fd);
+      return;
+    }
+
+    void *mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    int error = errno;
+    close(fd);
+
+    if (mapped == MAP_FAILED)
+      throw std::system_error(error, std::system_category(), filepath);
+
+    madvise(mapped, size, MADV_SEQUENTIAL);
+    data = static_cast<const char *>(mapped);
+  }
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  ~MappedFile() {
+    if (data) munmap(const_cast<char *>(data), size);
+  }
+};
+
+/*----------------------------------------------------------------------------*/
+/*                                CONSTRUCTORS                                */
+/*----------------------------------------------------------------------------*/
+
+TableFile::TableFile(const std::string &filepath)
+    : filepath_(filepath) {
+}
+
+/*----------------------------------------------------------------------------*/
+/*                              CONCRETE METHODS                              */
+/*----------------------------------------------------------------------------*/
+
+config::option::Probabilities TableFile::read() const {
+  config::option::Probabilities table;
+  read(table);
+  return table;
+}
+
+/*----------------------------------------------------------------------------*/
+
+void TableFile::read(config::option::Probabilities &table) const {
+  MappedFile file(filepath_);
+  if (file.data) parse(file.data, file.size, table);
+}
+
+/*----------------------------------------------------------------------------*/
+
+std::size_t TableFile::write(const config::option::Probabilities &table) const {
+  auto tmp_path = filepath_ + ".tmp";
+
+  std::size_t bytes = 0;
+  {
+    OutputBuffer dst(std::make_shared<std::ofstream>(tmp_path));
+
+    // Probabilities keep every significant digit, unlike the ones printed
+    // inside models, so that tables are read back exactly
+    char number[32];
+    for (const auto &entry : table) {
+      auto size = std::snprintf(number, sizeof(number), "%.17g", entry.second);
+      dst << entry.first.str() << '\t';
+      dst.append(number, static_cast<std::size_t>(size));
+      dst << '\n';
+    }
+
+    dst.flush();
+    bytes = dst.bytes();
+  }
+
+  if (std::rename(tmp_path.c_str(), filepath_.c_str()) != 0) {
+    std::remove(tmp_path.c_str());
+    throw std::runtime_error(filepath_ + ": Could not write table");
+  }
+
+  return bytes;
+}
+
+/*----------------------------------------------------------------------------*/
+
+void TableFile::parse(const char *data, std::size_t size,
+                      config::option::Probabilities &table) const {
+  auto end = data + size;
+
+  // Lines are counted first, so that the table is never rehashed
+  table.reserve(table.size()
+      + static_cast<std::size_t>(std::count(data, end, '\n')) + 1);
+
+  std::size_t line = 0;
+  for (auto begin = data; begin < end; ) {
+    auto line_end = static_cast<const char *>(
+        std::memchr(begin, '\n', static_cast<std::size_t>(end - begin)));
+    if (!line_end) line_end = end;
+
+    auto next = line_end + 1;
+    line++;
+
+    if (line_end != begin && *(line_end - 1) == '\r') line_end--;
+    if (line_end == begin || *begin == '#') {
+      begin = next;
+      continue;
+    }
+
+    auto tab = std::find(begin, line_end, '\t');
+    if (tab == line_end) invalid(line, "expected key and probability");
+
+    // Numbers are copied to be null-terminated, as the mapping is not
+    char number[64];
+    auto number_size = static_cast<std::size_t>(line_end - (tab + 1));
+    if (number_size == 0 || number_size >= sizeof(number))
+      invalid(line, "expected a probability");
+    std::memcpy(number, tab + 1, number_size);
+    number[number_size] = '\0';
+
+    char *number_end = nullptr;
+    double probability = std::strtod(number, &number_end);
+    if (number_end != number + number_size)
+      invalid(line, "expected a probability");
+
+    auto found = std::search(begin, tab, separator,
+                             separator + sizeof(separator) - 1);
+    if (found == tab) {
+      table[config::Condition(std::string(begin, tab))] = probability;
+    } else {
+      auto context = found + sizeof(separator) - 1;
+      table[config::Condition(begin, static_cast<std::size_t>(found - begin),
+                              context, static_cast<std::size_t>(tab - context))]
+        = probability;
+    }
+
+    begin = next;
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+
+void TableFile::invalid(std::size_t line, const std::string &reason) const {
+  throw std::logic_error(
+      filepath_ + ":" + std::to_string(line) + ": Invalid table entry, "
+      + reason);
+}
+
+/*----------------------------------------------------------------------------*/
+
+}  // namespace lang
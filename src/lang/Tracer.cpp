@@ -0,0 +1,223 @@
+/***********************************************************************/
+/*  Copyright 2016 ToPS                                                */
+/*                                                                     */
+/*  This program is free software; you can redistribute it and/or      */
+/*  modify it under the terms of the GNU  General Public License as    */
+/*  published by the Free Software Foundation; either version 3 of     */
+/*  the License, or (at your option) any later version.                */
+/*                                                                     */
+/*  This program is distributed in the hope that it will be useful,    */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of     */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the      */
+/*  GNU General Public License for more details.                       */
+/*                                                                     */
+/*  You should have received a copy of the GNU General Public License  */
+/*  along with this program; if not, write to the Free Software        */
+/*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,         */
+/*  MA 02110-1301, USA.                                                */
+/***********************************************************************/
+
+// Interface header
+#include "lang/Tracer.hpp"
+
+// Standard headers
+#include <map>
+#include <mutex>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <utility>
+#include <ostream>
+#include <algorithm>
+
+namespace lang {
+
+/*----------------------------------------------------------------------------*/
+/*                               LOCAL CONSTANTS                              */
+/*----------------------------------------------------------------------------*/
+
+// Span with the whole evaluation of one file, used to summarize by file
+static const std::string file_span = "file";
+
+/*----------------------------------------------------------------------------*/
+/*                               LOCAL FUNCTIONS                              */
+/*----------------------------------------------------------------------------*/
+
+static void writeJSONString(std::ostream &os, const std::string &string) {
+  os << '"';
+  for (char c : string) {
+    if (c == '"' || c == '\\') {
+      os << '\\' << c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      char escaped[8];
+      std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+      os << escaped;
+    } else {
+      os << c;
+    }
+  }
+  os << '"';
+}
+
+/*----------------------------------------------------------------------------*/
+/*                                INNER CLASSES                               */
+/*----------------------------------------------------------------------------*/
+
+Tracer::Span::Span(Tracer *tracer, const char *name, const std::string &file)
+    : tracer_(tracer), name_(name) {
+  if (!tracer_) return;
+  file_ = file;
+  start_ = std::chrono::steady_clock::now();
+}
+
+/*----------------------------------------------------------------------------*/
+
+Tracer::Span::Span(const std::shared_ptr<Tracer> &tracer,
+                   const char *name, const std::string &file)
+    : Span(tracer.get(), name, file) {
+}
+
+/*----------------------------------------------------------------------------*/
+
+Tracer::Span::~Span() {
+  if (!tracer_) return;
+  tracer_->record(name_, std::move(file_),
+                  start_, std::chrono::steady_clock::now());
+}
+
+/*----------------------------------------------------------------------------*/
+/*                                CONSTRUCTORS                                */
+/*----------------------------------------------------------------------------*/
+
+Tracer::Tracer()
+    : origin_(std::chrono::steady_clock::now()) {
+}
+
+/*----------------------------------------------------------------------------*/
+/*                              CONCRETE METHODS                              */
+/*----------------------------------------------------------------------------*/
+
+std::vector<Tracer::Event> Tracer::events() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return events_;
+}
+
+/*----------------------------------------------------------------------------*/
+
+void Tracer::writeChromeTrace(std::ostream &os) const {
+  auto events = this->events();
+
+  // Complete events ("ph": "X") are paired by the viewer from their times
+  os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  for (std::size_t i = 0; i < events.size(); i++) {
+    const auto &event = events[i];
+    os << (i == 0 ? "\n" : ",\n")
+       << "{\"name\":";
+    writeJSONString(os, event.name);
+    os << ",\"cat\":\"lang\",\"ph\":\"X\",\"pid\":1"
+       << ",\"tid\":" << event.thread
+       << ",\"ts\":" << std::to_string(event.start)
+       << ",\"dur\":" << std::to_string(event.duration)
+       << ",\"args\":{\"file\":";
+    writeJSONString(os, event.file);
+    os << "}}";
+  }
+  os << "\n]}" << std::endl;
+}
+
+/*----------------------------------------------------------------------------*/
+
+void Tracer::writeStatistics(std::ostream &os, std::size_t max_files) const {
+  auto events = this->events();
+
+  // Parents before children: sorted by thread, start and longest first
+  std::sort(events.begin(), events.end(),
+            [] (const Event &lhs, const Event &rhs) {
+    if (lhs.thread != rhs.thread) return lhs.thread < rhs.thread;
+    if (lhs.start != rhs.start) return lhs.start < rhs.start;
+    return lhs.duration > rhs.duration;
+  });
+
+  struct Statistics {
+    std::size_t evaluations = 0;
+    double total = 0;  // Including the files it references
+    double self = 0;   // Excluding the files it references
+  };
+
+  std::map<std::string, Statistics> files;
+
+  // Time of a file spent evaluating the files directly nested in it
+  std::vector<std::pair<const Event *, double>> open;
+  std::vector<std::pair<const Event *, double>> closed;
+
+  auto close = [&files] (const std::pair<const Event *, double> &span) {
+    auto &statistics = files[span.first->file];
+    statistics.evaluations++;
+    statistics.total += span.first->duration;
+    statistics.self += span.first->duration - span.second;
+  };
+
+  std::size_t thread = 0;
+  for (const auto &event : events) {
+    if (event.name != file_span) continue;
+
+    if (event.thread != thread) {
+      for (const auto &span : open) close(span);
+      open.clear();
+      thread = event.thread;
+    }
+
+    while (!open.empty()
+           && open.back().first->start + open.back().first->duration
+              <= event.start) {
+      close(open.back());
+      open.pop_back();
+    }
+
+    if (!open.empty()) open.back().second += event.duration;
+    open.emplace_back(&event, 0.0);
+  }
+  for (const auto &span : open) close(span);
+
+  std::vector<std::pair<std::string, Statistics>> slowest(files.begin(),
+                                                          files.end());
+  std::sort(slowest.begin(), slowest.end(),
+            [] (const std::pair<std::string, Statistics> &lhs,
+                const std::pair<std::string, Statistics> &rhs) {
+    return lhs.second.self > rhs.second.self;
+  });
+  if (slowest.size() > max_files) slowest.resize(max_files);
+
+  char line[64];
+  os << "    self ms    total ms  count  file" << std::endl;
+  for (const auto &file : slowest) {
+    std::snprintf(line, sizeof(line), "%11.3f %11.3f %6zu  ",
+                  file.second.self / 1000, file.second.total / 1000,
+                  file.second.evaluations);
+    os << line << file.first << std::endl;
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+
+void Tracer::record(const char *name, std::string file,
+                    std::chrono::steady_clock::time_point start,
+                    std::chrono::steady_clock::time_point end) {
+  using Microseconds = std::chrono::duration<double, std::micro>;
+
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  auto thread = threads_.emplace(std::this_thread::get_id(),
+                                 threads_.size() + 1).first->second;
+
+  events_.push_back({ name, std::move(file), thread,
+                      Microseconds(start - origin_).count(),
+                      Microseconds(end - start).count() });
+}
+
+/*----------------------------------------------------------------------------*/
+
+}  // namespace lang
@@ -0,0 +1,158 @@
+/***********************************************************************/
+/*  Copyright 2016 ToPS                                                */
+/*                                                                     */
+/*  This program is free software; you can redistribute it and/or      */
+/*  modify it under the terms of the GNU  General Public License as    */
+/*  published by the Free Software Foundation; either version 3 of     */
+/*  the License, or (at your option) any later version.                */
+/*                                                                     */
+/*  This program is distributed in the hope that it will be useful,    */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of     */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the      */
+/*  GNU General Public License for more details.                       */
+/*                                                                     */
+/*  You should have received a copy of the GNU General Public License  */
+/*  along with this program; if not, write to the Free Software        */
+/*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,         */
+/*  MA 02110-1301, USA.                                                */
+/***********************************************************************/
+
+// Interface header
+#include "model/MultiSequence.hpp"
+
+// Standard headers
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+namespace model {
+
+/*----------------------------------------------------------------------------*/
+/*                               LOCAL FUNCTIONS                              */
+/*----------------------------------------------------------------------------*/
+
+static std::size_t widthOf(Symbol symbol) {
+  return symbol <= UINT8_MAX ? 1 : symbol <= UINT16_MAX ? 2 : 4;
+}
+
+/*----------------------------------------------------------------------------*/
+
+// Reserved room is kept, in symbols, and the narrower vector is released
+template<typename Wide, typename Narrow>
+static void widenInto(std::vector<Wide> &wide, std::vector<Narrow> &narrow) {
+  wide.reserve(narrow.capacity());
+  wide.assign(narrow.begin(), narrow.end());
+  std::vector<Narrow>().swap(narrow);
+}
+
+/*----------------------------------------------------------------------------*/
+/*                                CONSTRUCTORS                                */
+/*----------------------------------------------------------------------------*/
+
+MultiSequence::MultiSequence(std::size_t number_of_tracks)
+    : tracks_(number_of_tracks) {
+}
+
+/*----------------------------------------------------------------------------*/
+/*                              CONCRETE METHODS                              */
+/*----------------------------------------------------------------------------*/
+
+void MultiSequence::reserve(std::size_t length) {
+  for (auto &track : tracks_) {
+    switch (track.width) {
+      case 1: track.narrow.reserve(length); break;
+      case 2: track.medium.reserve(length); break;
+      default: track.wide.reserve(length); break;
+    }
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+
+void MultiSequence::push_back(const std::vector<Symbol> &row) {
+  if (row.size() != tracks_.size())
+    throw std::invalid_argument("Row with " + std::to_string(row.size())
+                                + " symbols for "
+                                + std::to_string(tracks_.size()) + " tracks");
+
+  for (std::size_t i = 0; i < row.size(); i++) {
+    auto &track = tracks_[i];
+
+    auto width = widthOf(row[i]);
+    if (width > track.width) widen(track, width);
+
+    switch (track.width) {
+      case 1: track.narrow.push_back(static_cast<std::uint8_t>(row[i]));
+              break;
+      case 2: track.medium.push_back(static_cast<std::uint16_t>(row[i]));
+              break;
+      default: track.wide.push_back(static_cast<std::uint32_t>(row[i]));
+               break;
+    }
+  }
+
+  size_++;
+}
+
+/*----------------------------------------------------------------------------*/
+
+std::size_t MultiSequence::size() const {
+  return size_;
+}
+
+/*----------------------------------------------------------------------------*/
+
+std::size_t MultiSequence::tracks() const {
+  return tracks_.size();
+}
+
+/*----------------------------------------------------------------------------*/
+
+std::size_t MultiSequence::width(std::size_t track) const {
+  return tracks_.at(track).width;
+}
+
+/*----------------------------------------------------------------------------*/
+
+Symbol MultiSequence::at(std::size_t track, std::size_t position) const {
+  const auto &read = tracks_.at(track);
+  if (position >= size_)
+    throw std::out_of_range("Position " + std::to_string(position)
+                            + " out of sequence");
+
+  switch (read.width) {
+    case 1: return read.narrow[position];
+    case 2: return read.medium[position];
+    default: return read.wide[position];
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+
+Sequence MultiSequence::sequence(std::size_t track) const {
+  Sequence sequence;
+  sequence.reserve(size_);
+  scan(track, [&sequence] (const auto *symbols, std::size_t size) {
+    sequence.assign(symbols, symbols + size);
+  });
+  return sequence;
+}
+
+/*----------------------------------------------------------------------------*/
+
+void MultiSequence::widen(Track &track, std::size_t width) {
+  if (width == 2)
+    widenInto(track.medium, track.narrow);
+  else if (track.width == 1)
+    widenInto(track.wide, track.narrow);
+  else
+    widenInto(track.wide, track.medium);
+
+  track.width = width;
+}
+
+/*----------------------------------------------------------------------------*/
+
+}  // namespace model
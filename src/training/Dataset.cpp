@@ -0,0 +1,98 @@
+/***********************************************************************/
+/*  Copyright 2016 ToPS                                                */
+/*                                                                     */
+/*  This program is free software; you can redistribute it and/or      */
+/*  modify it under the terms of the GNU  General Public License as    */
+/*  published by the Free Software Foundation; either version 3 of     */
+/*  the License, or (at your option) any later version.                */
+/*                                                                     */
+/*  This program is distributed in the hope that it will be useful,    */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of     */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the      */
+/*  GNU General Public License for more details.                       */
+/*                                                                     */
+/*  You should have received a copy of the GNU General Public License  */
+/*  along with this program; if not, write to the Free Software        */
+/*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,         */
+/*  MA 02110-1301, USA.                                                */
+/***********************************************************************/
+
+// Interface header
+#include "training/Dataset.hpp"
+
+// Standard headers
+#include <string>
+#include <fstream>
+#include <utility>
+#include <stdexcept>
+
+namespace training {
+
+/*----------------------------------------------------------------------------*/
+/*                                 FUNCTIONS                                  */
+/*----------------------------------------------------------------------------*/
+
+Dataset readFasta(const std::string &filepath,
+                  config::ConverterPtr converter) {
+  std::ifstream src(filepath);
+  if (!src)
+    throw std::invalid_argument(filepath + ": Could not open training set");
+
+  Dataset dataset;
+
+  std::string line;
+  std::string symbol(1, '\0');
+  while (std::getline(src, line)) {
+    if (line.empty() || line[0] == ';') continue;
+
+    if (line[0] == '>') {
+      dataset.emplace_back();
+      continue;
+    }
+
+    if (dataset.empty())
+      throw std::logic_error(filepath + ": Sequence data before FASTA header");
+
+    for (char c : line) {
+      if (c == '\r' || c == ' ') continue;
+      symbol[0] = c;
+      dataset.back().push_back(converter->convert(symbol));
+    }
+  }
+
+  return dataset;
+}
+
+/*----------------------------------------------------------------------------*/
+
+model::MultiSequence readTracks(std::istream &src,
+                                const std::vector<config::ConverterPtr>
+                                  &converters) {
+  model::MultiSequence tracks(converters.size());
+
+  std::string line;
+  std::string field;
+  std::vector<model::Symbol> row(converters.size());
+  while (std::getline(src, line)) {
+    // Missing columns are read as empty symbols
+    std::size_t begin = 0;
+    for (std::size_t i = 0; i < converters.size(); i++) {
+      if (begin > line.size()) {
+        field.clear();
+      } else {
+        auto end = line.find('\t', begin);
+        if (end == std::string::npos) end = line.size();
+        field.assign(line, begin, end - begin);
+        begin = end + 1;
+      }
+      row[i] = converters[i]->convert(field);
+    }
+    tracks.push_back(row);
+  }
+
+  return tracks;
+}
+
+/*----------------------------------------------------------------------------*/
+
+}  // namespace training
@@ -0,0 +1,364 @@
+/***********************************************************************/
+/*  Copyright 2016 ToPS                                                */
+/*                                                                     */
+/*  This program is free software; you can redistribute it and/or      */
+/*  modify it under the terms of the GNU  General Public License as    */
+/*  published by the Free Software Foundation; either version 3 of     */
+/*  the License, or (at your option) any later version.                */
+/*                                                                     */
+/*  This program is distributed in the hope that it will be useful,    */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of     */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the      */
+/*  GNU General Public License for more details.                       */
+/*                                                                     */
+/*  You should have received a copy of the GNU General Public License  */
+/*  along with this program; if not, write to the Free Software        */
+/*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,         */
+/*  MA 02110-1301, USA.                                                */
+/***********************************************************************/
+
+// Interface header
+#include "training/GHMMTrainer.hpp"
+
+// Standard headers
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <fstream>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+#include <stdexcept>
+#include <future>
+
+// Internal headers
+#include "config/Condition.hpp"
+#include "config/BasicConfig.hpp"
+#include "config/StateConfig.hpp"
+#include "config/FixedDurationConfig.hpp"
+#include "config/ExplicitDurationConfig.hpp"
+#include "config/GeometricDurationConfig.hpp"
+#include "config/StringLiteralSuffix.hpp"
+
+#include "training/IIDTrainer.hpp"
+
+#include "lang/Util.hpp"
+
+#include "filesystem/Filesystem.hpp"
+
+// Using declarations
+using config::operator ""_t;
+
+namespace training {
+
+/*----------------------------------------------------------------------------*/
+/*                              LOCAL FUNCTIONS                               */
+/*----------------------------------------------------------------------------*/
+
+static std::size_t indexOf(const config::option::Alphabet &alphabet,
+                           const std::string &symbol) {
+  auto it = std::find(alphabet.begin(), alphabet.end(), symbol);
+  if (it == alphabet.end())
+    throw std::invalid_argument("Unknown state: " + symbol);
+  return std::distance(alphabet.begin(), it);
+}
+
+/*----------------------------------------------------------------------------*/
+/*                                CONSTRUCTORS                                */
+/*----------------------------------------------------------------------------*/
+
+GHMMTrainer::GHMMTrainer(config::option::Alphabet observations,
+                         config::option::Alphabet labels,
+                         double pseudo_counter)
+    : observations_(std::move(observations)),
+      labels_(std::move(labels)),
+      pseudo_counter_(pseudo_counter),
+      max_buffered_symbols_(0),
+      states_(labels_.size()) {
+  IIDTrainer iid_trainer(observations_, pseudo_counter_);
+  for (auto &state : states_) {
+    state.emission_trainer = [iid_trainer] (const Dataset &training_set,
+                                            const std::string &filepath) {
+      return config::ModelConfigPtr(iid_trainer.train(training_set, filepath));
+    };
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+/*                              CONCRETE METHODS                              */
+/*----------------------------------------------------------------------------*/
+
+void GHMMTrainer::setEmissionTrainer(const std::string &state,
+                                     EmissionTrainer trainer) {
+  states_[indexOf(labels_, state)].emission_trainer = std::move(trainer);
+}
+
+/*----------------------------------------------------------------------------*/
+
+void GHMMTrainer::setGeometricDuration(const std::string &state) {
+  states_[indexOf(labels_, state)].geometric = true;
+}
+
+/*----------------------------------------------------------------------------*/
+
+void GHMMTrainer::setSpilling(const std::string &spill_dir,
+                              std::size_t max_symbols) {
+  spill_dir_ = lang::cleanPath(spill_dir + "/");
+  max_buffered_symbols_ = max_symbols;
+}
+
+/*----------------------------------------------------------------------------*/
+
+config::GHMMConfigPtr GHMMTrainer::train(const std::string &dataset_path,
+                                         const std::string &filepath) {
+  reset();
+
+  auto observations = std::make_shared<config::Domain>(
+    config::Domain::discrete_domain{}, observations_);
+  auto labels = std::make_shared<config::Domain>(
+    config::Domain::discrete_domain{}, labels_);
+
+  auto observation_converter = observations->makeConverter();
+  auto label_converter = labels->makeConverter();
+
+  std::ifstream src(dataset_path);
+  if (!src)
+    throw std::invalid_argument(dataset_path + ": Could not open dataset");
+
+  std::string line;
+  std::getline(src, line);  // Header
+
+  model::Sequence segment;
+  model::Symbol current_label = 0;
+  int previous_label = -1;
+
+  while (std::getline(src, line)) {
+    if (!line.empty() && line.back() == '\r') line.pop_back();
+
+    if (line.empty()) {
+      closeSegment(current_label, segment, previous_label);
+      previous_label = -1;
+      continue;
+    }
+
+    auto first_tab = line.find('\t');
+    auto last_tab = line.rfind('\t');
+    if (first_tab == std::string::npos)
+      throw std::logic_error(dataset_path + ": Missing label column");
+
+    auto symbol = observation_converter->convert(line.substr(0, first_tab));
+    auto label = label_converter->convert(line.substr(last_tab + 1));
+
+    if (label != current_label)
+      closeSegment(current_label, segment, previous_label);
+
+    current_label = label;
+    segment.push_back(symbol);
+  }
+  closeSegment(current_label, segment, previous_label);
+
+  // Every label declared by the GHMM needs a state
+  for (std::size_t l = 0; l < labels_.size(); l++)
+    if (states_[l].durations.empty())
+      throw std::logic_error(
+        dataset_path + ": No training segments for label " + labels_[l].str());
+
+  // Sub-trainers
+  auto root_dir = lang::extractDir(filepath);
+
+  std::vector<std::future<config::StateConfigPtr>> futures(labels_.size());
+  for (std::size_t l = 0; l < labels_.size(); l++) {
+    futures[l] = std::async(std::launch::async, [this, l, root_dir, filepath] {
+      auto state_ptr = std::make_shared<config::StateConfig>(filepath);
+
+      std::get<decltype("emission"_t)>(*state_ptr)
+        = states_[l].emission_trainer(
+            loadSegments(l), root_dir + labels_[l].str() + "Emission.tops");
+
+      std::get<decltype("duration"_t)>(*state_ptr)
+        = trainDuration(l, filepath);
+
+      return state_ptr;
+    });
+  }
+
+  auto ghmm_ptr = config::GHMMConfig::make(filepath);
+  std::get<decltype("model_type"_t)>(*ghmm_ptr) = "GHMM";
+  std::get<decltype("observations"_t)>(*ghmm_ptr) = observations;
+  std::get<decltype("labels"_t)>(*ghmm_ptr) = labels;
+
+  std::get<decltype("initial_probabilities"_t)>(*ghmm_ptr)
+    = normalize(initial_counts_);
+
+  auto &transitions
+    = std::get<decltype("transition_probabilities"_t)>(*ghmm_ptr);
+  for (std::size_t l = 0; l < labels_.size(); l++) {
+    auto probabilities = normalize(transition_counts_[l], labels_[l]);
+    transitions.insert(probabilities.begin(), probabilities.end());
+  }
+
+  auto &states = std::get<decltype("states"_t)>(*ghmm_ptr);
+  for (std::size_t l = 0; l < labels_.size(); l++)
+    states[labels_[l]] = futures[l].get();
+
+  return ghmm_ptr;
+}
+
+/*----------------------------------------------------------------------------*/
+
+void GHMMTrainer::reset() {
+  for (auto &state : states_) {
+    state.durations.clear();
+    state.segments.clear();
+    state.buffered_symbols = 0;
+    state.spilled_segments = 0;
+  }
+
+  initial_counts_.assign(labels_.size(), 0);
+  transition_counts_.assign(labels_.size(),
+                            std::vector<double>(labels_.size(), 0));
+
+  if (max_buffered_symbols_ > 0) {
+    filesystem::create_directories(spill_dir_);
+    for (std::size_t l = 0; l < labels_.size(); l++)
+      std::ofstream(spillPath(l), std::ios::binary | std::ios::trunc);
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+
+void GHMMTrainer::closeSegment(model::Symbol label,
+                               model::Sequence &segment,
+                               int &previous_label) {
+  if (segment.empty()) return;
+
+  auto &state = states_[label];
+
+  if (state.durations.size() <= segment.size())
+    state.durations.resize(segment.size() + 1, 0);
+  state.durations[segment.size()]++;
+
+  if (previous_label < 0)
+    initial_counts_[label]++;
+  else
+    transition_counts_[previous_label][label]++;
+
+  if (state.geometric)
+    transition_counts_[label][label] += segment.size() - 1;
+
+  state.buffered_symbols += segment.size();
+  state.segments.push_back(std::move(segment));
+  segment.clear();
+
+  if (max_buffered_symbols_ > 0
+  &&  state.buffered_symbols > max_buffered_symbols_)
+    spill(label);
+
+  previous_label = label;
+}
+
+/*----------------------------------------------------------------------------*/
+
+std::string GHMMTrainer::spillPath(model::Symbol label) const {
+  return spill_dir_ + labels_[label].str() + ".seq";
+}
+
+/*----------------------------------------------------------------------------*/
+
+void GHMMTrainer::spill(model::Symbol label) {
+  auto &state = states_[label];
+  std::ofstream dst(spillPath(label), std::ios::binary | std::ios::app);
+
+  for (const auto &segment : state.segments) {
+    std::uint64_t size = segment.size();
+    dst.write(reinterpret_cast<const char *>(&size), sizeof(size));
+    dst.write(reinterpret_cast<const char *>(segment.data()),
+              size * sizeof(model::Symbol));
+  }
+
+  state.spilled_segments += state.segments.size();
+  state.segments.clear();
+  state.buffered_symbols = 0;
+}
+
+/*----------------------------------------------------------------------------*/
+
+Dataset GHMMTrainer::loadSegments(model::Symbol label) {
+  auto &state = states_[label];
+  if (state.spilled_segments == 0) return std::move(state.segments);
+
+  Dataset segments;
+  segments.reserve(state.spilled_segments + state.segments.size());
+
+  std::ifstream src(spillPath(label), std::ios::binary);
+  for (std::size_t s = 0; s < state.spilled_segments; s++) {
+    std::uint64_t size = 0;
+    src.read(reinterpret_cast<char *>(&size), sizeof(size));
+    segments.emplace_back(size);
+    src.read(reinterpret_cast<char *>(segments.back().data()),
+             size * sizeof(model::Symbol));
+  }
+
+  std::move(state.segments.begin(), state.segments.end(),
+            std::back_inserter(segments));
+  state.segments.clear();
+
+  return segments;
+}
+
+/*----------------------------------------------------------------------------*/
+
+config::DurationConfigPtr
+GHMMTrainer::trainDuration(model::Symbol label, const std::string &filepath) {
+  auto &state = states_[label];
+
+  if (state.geometric)
+    return config::GeometricDurationConfig::make(filepath, "geometric");
+
+  auto lengths = std::count_if(state.durations.begin(), state.durations.end(),
+                               [] (double count) { return count > 0; });
+
+  if (lengths == 1) {
+    auto duration_ptr = config::FixedDurationConfig::make(filepath, "fixed");
+    std::get<decltype("size"_t)>(*duration_ptr) = state.durations.size() - 1;
+    return duration_ptr;
+  }
+
+  config::option::Alphabet sizes;
+  for (std::size_t d = 1; d < state.durations.size(); d++)
+    sizes.push_back(std::to_string(d));
+
+  IIDTrainer iid_trainer(sizes);
+  auto duration_ptr = config::ExplicitDurationConfig::make(filepath,
+                                                           "explicit");
+  std::get<decltype("model"_t)>(*duration_ptr) = iid_trainer.train(
+    std::vector<double>(state.durations.begin() + 1, state.durations.end()),
+    lang::extractDir(filepath) + labels_[label].str() + "Duration.tops");
+  std::get<decltype("max_size"_t)>(*duration_ptr) = sizes.size();
+
+  return duration_ptr;
+}
+
+/*----------------------------------------------------------------------------*/
+
+config::option::Probabilities
+GHMMTrainer::normalize(const std::vector<double> &counts,
+                       const std::string &condition) const {
+  double total = 0;
+  for (auto count : counts) total += count;
+
+  config::option::Probabilities probabilities;
+  for (std::size_t l = 0; l < counts.size(); l++) {
+    if (counts[l] == 0) continue;
+    auto key = condition.empty() ? config::Condition(labels_[l])
+                                 : config::Condition(labels_[l], condition);
+    probabilities[key] = counts[l] / total;
+  }
+
+  return probabilities;
+}
+
+/*----------------------------------------------------------------------------*/
+
+}  // namespace training
@@ -0,0 +1,87 @@
+/***********************************************************************/
+/*  Copyright 2016 ToPS                                                */
+/*                                                                     */
+/*  This program is free software; you can redistribute it and/or      */
+/*  modify it under the terms of the GNU  General Public License as    */
+/*  published by the Free Software Foundation; either version 3 of     */
+/*  the License, or (at your option) any later version.                */
+/*                                                                     */
+/*  This program is distributed in the hope that it will be useful,    */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of     */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the      */
+/*  GNU General Public License for more details.                       */
+/*                                                                     */
+/*  You should have received a copy of the GNU General Public License  */
+/*  along with this program; if not, write to the Free Software        */
+/*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,         */
+/*  MA 02110-1301, USA.                                                */
+/***********************************************************************/
+
+// Interface header
+#include "training/IIDTrainer.hpp"
+
+// Standard headers
+#include <memory>
+#include <string>
+#include <vector>
+#include <utility>
+
+// Internal headers
+#include "config/BasicConfig.hpp"
+#include "config/StringLiteralSuffix.hpp"
+
+// Using declarations
+using config::operator ""_t;
+
+namespace training {
+
+/*----------------------------------------------------------------------------*/
+/*                                CONSTRUCTORS                                */
+/*----------------------------------------------------------------------------*/
+
+IIDTrainer::IIDTrainer(config::option::Alphabet alphabet,
+                       double pseudo_counter)
+    : alphabet_(std::move(alphabet)),
+      domain_(std::make_shared<config::Domain>(
+          config::Domain::discrete_domain{}, alphabet_)),
+      pseudo_counter_(pseudo_counter) {
+}
+
+/*----------------------------------------------------------------------------*/
+/*                              CONCRETE METHODS                              */
+/*----------------------------------------------------------------------------*/
+
+config::IIDConfigPtr IIDTrainer::train(const Dataset &training_set,
+                                       const std::string &filepath) const {
+  std::vector<double> counts(alphabet_.size(), 0);
+  for (const auto &sequence : training_set)
+    for (auto symbol : sequence)
+      counts[symbol]++;
+
+  return train(counts, filepath);
+}
+
+/*----------------------------------------------------------------------------*/
+
+config::IIDConfigPtr IIDTrainer::train(const std::vector<double> &counts,
+                                       const std::string &filepath) const {
+  double total = 0;
+  for (std::size_t s = 0; s < alphabet_.size(); s++)
+    total += counts[s] + pseudo_counter_;
+
+  auto iid_ptr = config::IIDConfig::make(filepath);
+  std::get<decltype("model_type"_t)>(*iid_ptr) = "IID";
+  std::get<decltype("observations"_t)>(*iid_ptr) = domain_;
+
+  auto &probabilities
+    = std::get<decltype("emission_probabilities"_t)>(*iid_ptr);
+  for (std::size_t s = 0; s < alphabet_.size(); s++)
+    probabilities[alphabet_[s]]
+      = total > 0 ? (counts[s] + pseudo_counter_) / total : 0;
+
+  return iid_ptr;
+}
+
+/*----------------------------------------------------------------------------*/
+
+}  // namespace training
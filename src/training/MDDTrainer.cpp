@@ -0,0 +1,337 @@
+/***********************************************************************/
+/*  Copyright 2016 ToPS                                                */
+/*                                                                     */
+/*  This program is free software; you can redistribute it and/or      */
+/*  modify it under the terms of the GNU  General Public License as    */
+/*  published by the Free Software Foundation; either version 3 of     */
+/*  the License, or (at your option) any later version.                */
+/*                                                                     */
+/*  This program is distributed in the hope that it will be useful,    */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of     */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the      */
+/*  GNU General Public License for more details.                       */
+/*                                                                     */
+/*  You should have received a copy of the GNU General Public License  */
+/*  along with this program; if not, write to the Free Software        */
+/*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,         */
+/*  MA 02110-1301, USA.                                                */
+/***********************************************************************/
+
+// Interface header
+#include "training/MDDTrainer.hpp"
+
+// Standard headers
+#include <cmath>
+#include <bitset>
+#include <memory>
+#include <string>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+
+// Internal headers
+#include "config/BasicConfig.hpp"
+#include "config/IIDConfig.hpp"
+#include "config/IMCConfig.hpp"
+#include "config/DiscreteConverter.hpp"
+#include "config/StringLiteralSuffix.hpp"
+
+#include "lang/Util.hpp"
+
+// Using declarations
+using config::operator ""_t;
+
+namespace training {
+
+/*----------------------------------------------------------------------------*/
+/*                              LOCAL FUNCTIONS                               */
+/*----------------------------------------------------------------------------*/
+
+static std::size_t count(const MDDTrainer::Bitset &a) {
+  std::size_t total = 0;
+  for (std::size_t w = 0; w < a.size(); w++)
+    total += std::bitset<64>(a[w]).count();
+  return total;
+}
+
+/*----------------------------------------------------------------------------*/
+
+static std::size_t count(const MDDTrainer::Bitset &a,
+                         const MDDTrainer::Bitset &b) {
+  std::size_t total = 0;
+  for (std::size_t w = 0; w < a.size(); w++)
+    total += std::bitset<64>(a[w] & b[w]).count();
+  return total;
+}
+
+/*----------------------------------------------------------------------------*/
+
+static std::size_t count(const MDDTrainer::Bitset &a,
+                         const MDDTrainer::Bitset &b,
+                         const MDDTrainer::Bitset &c) {
+  std::size_t total = 0;
+  for (std::size_t w = 0; w < a.size(); w++)
+    total += std::bitset<64>(a[w] & b[w] & c[w]).count();
+  return total;
+}
+
+/*----------------------------------------------------------------------------*/
+
+static double chiSquareCriticalValue(std::size_t degrees_of_freedom) {
+  // Wilson-Hilferty approximation for a significance level of 0.001
+  const double z = 3.090232;
+  const double k = std::max<std::size_t>(degrees_of_freedom, 1);
+  const double c = 2.0 / (9.0 * k);
+  return k * std::pow(1.0 - c + z * std::sqrt(c), 3);
+}
+
+/*----------------------------------------------------------------------------*/
+/*                                CONSTRUCTORS                                */
+/*----------------------------------------------------------------------------*/
+
+MDDTrainer::MDDTrainer(config::option::Alphabet alphabet,
+                       std::vector<config::option::Symbol> consensus_sequence,
+                       unsigned int minimum_subset)
+    : alphabet_(std::move(alphabet)),
+      domain_(std::make_shared<config::Domain>(
+          config::Domain::discrete_domain{}, alphabet_)),
+      minimum_subset_(minimum_subset),
+      critical_value_(chiSquareCriticalValue(alphabet_.size() - 1)),
+      next_node_(0) {
+  if (consensus_sequence.empty())
+    throw std::invalid_argument("MDD trainer: Empty consensus sequence");
+
+  config::DiscreteConverter converter(alphabet_);
+
+  // Consensus symbols are written as "A" | "C", which yields "A | C"
+  for (const std::string &position : consensus_sequence) {
+    std::vector<model::Symbol> symbols;
+
+    std::string::size_type begin = 0;
+    while (begin <= position.size()) {
+      auto end = position.find(" | ", begin);
+      if (end == std::string::npos) end = position.size();
+
+      auto symbol = position.substr(begin, end - begin);
+      try {
+        symbols.push_back(converter.convert(symbol));
+      } catch (const std::out_of_range &) {
+        throw std::invalid_argument(
+          "MDD trainer: Consensus symbol \"" + symbol
+          + "\" is not in the alphabet");
+      }
+
+      begin = end + 3;
+    }
+
+    consensus_.push_back(std::move(symbols));
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+/*                              CONCRETE METHODS                              */
+/*----------------------------------------------------------------------------*/
+
+config::MDDConfigPtr MDDTrainer::train(const Dataset &training_set,
+                                       const std::string &filepath) {
+  if (training_set.empty())
+    throw std::invalid_argument(filepath + ": Empty training set");
+
+  root_dir_ = lang::extractDir(filepath);
+  tree_path_ = root_dir_ + "dependency.tree";
+  next_node_ = 0;
+
+  sliceTrainingSet(training_set);
+
+  Bitset subset(planes_[0][0].size(), 0);
+  for (std::size_t s = 0; s < training_set.size(); s++)
+    subset[s / 64] |= std::uint64_t(1) << (s % 64);
+
+  auto mdd_ptr = config::MDDConfig::make(filepath);
+  std::get<decltype("model_type"_t)>(*mdd_ptr) = "MDD";
+  std::get<decltype("observations"_t)>(*mdd_ptr) = domain_;
+  std::get<decltype("consensus"_t)>(*mdd_ptr) = consensusPattern();
+  std::get<decltype("dependencies"_t)>(*mdd_ptr).push_back(
+    makeNode(subset, std::vector<bool>(consensus_.size(), false)));
+
+  return mdd_ptr;
+}
+
+/*----------------------------------------------------------------------------*/
+
+void MDDTrainer::sliceTrainingSet(const Dataset &training_set) {
+  std::size_t length = consensus_.size();
+  std::size_t words = (training_set.size() + 63) / 64;
+
+  planes_.assign(length,
+    std::vector<Bitset>(alphabet_.size(), Bitset(words, 0)));
+  consensus_planes_.assign(length, Bitset(words, 0));
+
+  for (std::size_t s = 0; s < training_set.size(); s++) {
+    if (training_set[s].size() != length)
+      throw std::logic_error(
+        "Training sequence " + std::to_string(s + 1)
+        + " does not have the length of the consensus");
+
+    for (std::size_t p = 0; p < length; p++) {
+      if (training_set[s][p] >= alphabet_.size())
+        throw std::logic_error(
+          "Training sequence " + std::to_string(s + 1)
+          + " has a symbol out of the alphabet at position "
+          + std::to_string(p + 1));
+
+      planes_[p][training_set[s][p]][s / 64] |= std::uint64_t(1) << (s % 64);
+    }
+  }
+
+  for (std::size_t p = 0; p < length; p++)
+    for (auto symbol : consensus_[p])
+      for (std::size_t w = 0; w < words; w++)
+        consensus_planes_[p][w] |= planes_[p][symbol][w];
+}
+
+/*----------------------------------------------------------------------------*/
+
+config::DependencyTreeConfigPtr
+MDDTrainer::makeNode(const Bitset &subset, std::vector<bool> used) {
+  if (count(subset) < minimum_subset_)
+    return makeLeaf(subset);
+
+  auto split = findSplit(subset, used);
+  if (!split.significant)
+    return makeLeaf(subset);
+
+  Bitset consensus_subset(subset.size()), other_subset(subset.size());
+  for (std::size_t w = 0; w < subset.size(); w++) {
+    consensus_subset[w] = subset[w] & consensus_planes_[split.position][w];
+    other_subset[w] = subset[w] & ~consensus_planes_[split.position][w];
+  }
+
+  auto tree_ptr = config::DependencyTreeConfig::make(tree_path_);
+  std::get<decltype("position"_t)>(*tree_ptr)
+    = std::to_string(split.position);
+  std::get<decltype("configuration"_t)>(*tree_ptr) = trainModel(subset);
+
+  used[split.position] = true;
+  tree_ptr->children().push_back(makeNode(consensus_subset, used));
+  tree_ptr->children().push_back(makeLeaf(other_subset));
+
+  return tree_ptr;
+}
+
+/*----------------------------------------------------------------------------*/
+
+config::DependencyTreeConfigPtr MDDTrainer::makeLeaf(const Bitset &subset) {
+  auto tree_ptr = config::DependencyTreeConfig::make(tree_path_);
+  std::get<decltype("position"_t)>(*tree_ptr) = "*";
+  std::get<decltype("configuration"_t)>(*tree_ptr) = trainModel(subset);
+  return tree_ptr;
+}
+
+/*----------------------------------------------------------------------------*/
+
+MDDTrainer::Split MDDTrainer::findSplit(const Bitset &subset,
+                                        const std::vector<bool> &used) {
+  double total = count(subset);
+  std::vector<Split> splits(consensus_.size());
+
+  for (std::size_t i = 0; i < consensus_.size(); i++) {
+    splits[i].position = i;
+    if (used[i]) continue;
+
+    pool_.enqueue([this, i, total, &subset, &used, &splits] {
+      double consensus_total = count(subset, consensus_planes_[i]);
+      if (consensus_total == 0 || consensus_total == total) return;
+
+      for (std::size_t j = 0; j < consensus_.size(); j++) {
+        if (j == i || used[j]) continue;
+        double statistic = chiSquare(i, j, subset, total, consensus_total);
+        splits[i].statistic += statistic;
+        splits[i].significant |= (statistic > critical_value_);
+      }
+    });
+  }
+
+  pool_.wait();
+
+  Split best;
+  for (const auto &split : splits)
+    if (split.significant && split.statistic > best.statistic)
+      best = split;
+
+  return best;
+}
+
+/*----------------------------------------------------------------------------*/
+
+double MDDTrainer::chiSquare(std::size_t i, std::size_t j,
+                             const Bitset &subset,
+                             double total, double consensus_total) const {
+  double statistic = 0;
+
+  for (std::size_t a = 0; a < alphabet_.size(); a++) {
+    double column_total = count(subset, planes_[j][a]);
+    if (column_total == 0) continue;
+
+    double observed[2];
+    observed[0] = count(subset, consensus_planes_[i], planes_[j][a]);
+    observed[1] = column_total - observed[0];
+
+    double expected[2];
+    expected[0] = consensus_total * column_total / total;
+    expected[1] = (total - consensus_total) * column_total / total;
+
+    for (unsigned int r = 0; r < 2; r++)
+      statistic += (observed[r] - expected[r]) * (observed[r] - expected[r])
+                 / expected[r];
+  }
+
+  return statistic;
+}
+
+/*----------------------------------------------------------------------------*/
+
+config::ModelConfigPtr MDDTrainer::trainModel(const Bitset &subset) {
+  auto name = "node" + std::to_string(next_node_++);
+  double total = count(subset);
+
+  auto imc_ptr = config::IMCConfig::make(root_dir_ + name + ".tops");
+  std::get<decltype("model_type"_t)>(*imc_ptr) = "IMC";
+  std::get<decltype("observations"_t)>(*imc_ptr) = domain_;
+
+  for (std::size_t p = 0; p < consensus_.size(); p++) {
+    auto iid_ptr = config::IIDConfig::make(
+      root_dir_ + name + "/p" + std::to_string(p) + ".tops");
+    std::get<decltype("model_type"_t)>(*iid_ptr) = "IID";
+    std::get<decltype("observations"_t)>(*iid_ptr) = domain_;
+
+    auto &probabilities
+      = std::get<decltype("emission_probabilities"_t)>(*iid_ptr);
+    for (std::size_t a = 0; a < alphabet_.size(); a++)
+      probabilities[alphabet_[a]] = count(subset, planes_[p][a]) / total;
+
+    std::get<decltype("position_specific_distributions"_t)>(*imc_ptr)
+      .push_back(iid_ptr);
+  }
+
+  return imc_ptr;
+}
+
+/*----------------------------------------------------------------------------*/
+
+config::option::Pattern MDDTrainer::consensusPattern() const {
+  config::option::Pattern pattern;
+
+  for (const auto &symbols : consensus_) {
+    if (symbols.size() > 1) pattern += "[";
+    for (auto symbol : symbols) pattern += alphabet_[symbol];
+    if (symbols.size() > 1) pattern += "]";
+  }
+
+  return pattern;
+}
+
+/*----------------------------------------------------------------------------*/
+
+}  // namespace training
@@ -0,0 +1,129 @@
+/***********************************************************************/
+/*  Copyright 2016 ToPS                                                */
+/*                                                                     */
+/*  This program is free software; you can redistribute it and/or      */
+/*  modify it under the terms of the GNU  General Public License as    */
+/*  published by the Free Software Foundation; either version 3 of     */
+/*  the License, or (at your option) any later version.                */
+/*                                                                     */
+/*  This program is distributed in the hope that it will be useful,    */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of     */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the      */
+/*  GNU General Public License for more details.                       */
+/*                                                                     */
+/*  You should have received a copy of the GNU General Public License  */
+/*  along with this program; if not, write to the Free Software        */
+/*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,         */
+/*  MA 02110-1301, USA.                                                */
+/***********************************************************************/
+
+// Standard headers
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+// Internal headers
+#include "model/Symbol.hpp"
+#include "model/MultiSequence.hpp"
+
+// External headers
+#include "gmock/gmock.h"
+
+// Using declarations
+using ::testing::Eq;
+using ::testing::ElementsAre;
+
+using model::MultiSequence;
+
+/*----------------------------------------------------------------------------*/
+/*                                  FIXTURES                                  */
+/*----------------------------------------------------------------------------*/
+
+// Track 0 only holds one-byte symbols, while track 1 is widened to two
+// and then to four bytes in the middle of the sequence
+class AMultiSequence : public testing::Test {
+ protected:
+  MultiSequence tracks { 2 };
+
+  void SetUp() override {
+    tracks.reserve(2);
+    tracks.push_back({ 1, 7 });
+    tracks.push_back({ 2, 300 });
+    tracks.push_back({ 3, 70000 });
+    tracks.push_back({ 255, 8 });
+  }
+};
+
+/*----------------------------------------------------------------------------*/
+/*                                   TESTS                                    */
+/*----------------------------------------------------------------------------*/
+
+TEST_F(AMultiSequence, KeepsTheNarrowestWidthOfEachTrack) {
+  ASSERT_THAT(tracks.size(), Eq(4u));
+  ASSERT_THAT(tracks.tracks(), Eq(2u));
+  ASSERT_THAT(tracks.width(0), Eq(1u));
+  ASSERT_THAT(tracks.width(1), Eq(4u));
+}
+
+/*----------------------------------------------------------------------------*/
+
+TEST_F(AMultiSequence, KeepsSymbolsAppendedBeforeWidening) {
+  ASSERT_THAT(tracks.at(1, 0), Eq(7u));
+  ASSERT_THAT(tracks.at(1, 1), Eq(300u));
+  ASSERT_THAT(tracks.at(1, 2), Eq(70000u));
+  ASSERT_THAT(tracks.at(1, 3), Eq(8u));
+}
+
+/*----------------------------------------------------------------------------*/
+
+TEST_F(AMultiSequence, WidensFromOneToFourBytesAtOnce) {
+  MultiSequence widened(1);
+  widened.push_back({ 5 });
+  widened.push_back({ 100000 });
+
+  ASSERT_THAT(widened.width(0), Eq(4u));
+  ASSERT_THAT(widened.sequence(0), ElementsAre(5u, 100000u));
+}
+
+/*----------------------------------------------------------------------------*/
+
+TEST_F(AMultiSequence, ConvertsTracksIntoSequences) {
+  ASSERT_THAT(tracks.sequence(0), ElementsAre(1u, 2u, 3u, 255u));
+  ASSERT_THAT(tracks.sequence(1), ElementsAre(7u, 300u, 70000u, 8u));
+}
+
+/*----------------------------------------------------------------------------*/
+
+TEST_F(AMultiSequence, ScansTracksWithTheirOwnWidth) {
+  std::size_t narrow_width = 0, wide_width = 0;
+  std::vector<model::Symbol> scanned;
+
+  tracks.scan(0, [&] (const auto *symbols, std::size_t size) {
+    narrow_width = sizeof(*symbols);
+    scanned.assign(symbols, symbols + size);
+  });
+  tracks.scan(1, [&] (const auto *symbols, std::size_t /* size */) {
+    wide_width = sizeof(*symbols);
+  });
+
+  ASSERT_THAT(narrow_width, Eq(sizeof(std::uint8_t)));
+  ASSERT_THAT(wide_width, Eq(sizeof(std::uint32_t)));
+  ASSERT_THAT(scanned, ElementsAre(1u, 2u, 3u, 255u));
+}
+
+/*----------------------------------------------------------------------------*/
+
+TEST_F(AMultiSequence, RejectsRowsOfTheWrongSize) {
+  ASSERT_THROW(tracks.push_back({ 1 }), std::invalid_argument);
+  ASSERT_THAT(tracks.size(), Eq(4u));
+}
+
+/*----------------------------------------------------------------------------*/
+
+TEST_F(AMultiSequence, RejectsPositionsOutOfTheSequence) {
+  ASSERT_THROW(tracks.at(0, 4), std::out_of_range);
+  ASSERT_THROW(tracks.at(2, 0), std::out_of_range);
+}
+
+/*----------------------------------------------------------------------------*/
@@ -0,0 +1,89 @@
+/***********************************************************************/
+/*  Copyright 2016 ToPS                                                */
+/*                                                                     */
+/*  This program is free software; you can redistribute it and/or      */
+/*  modify it under the terms of the GNU  General Public License as    */
+/*  published by the Free Software Foundation; either version 3 of     */
+/*  the License, or (at your option) any later version.                */
+/*                                                                     */
+/*  This program is distributed in the hope that it will be useful,    */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of     */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the      */
+/*  GNU General Public License for more details.                       */
+/*                                                                     */
+/*  You should have received a copy of the GNU General Public License  */
+/*  along with this program; if not, write to the Free Software        */
+/*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,         */
+/*  MA 02110-1301, USA.                                                */
+/***********************************************************************/
+
+// Standard headers
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+
+// Internal headers
+#include "config/Converter.hpp"
+#include "config/RangeConverter.hpp"
+#include "config/DiscreteConverter.hpp"
+
+#include "training/Dataset.hpp"
+
+// External headers
+#include "gmock/gmock.h"
+
+// Using declarations
+using ::testing::Eq;
+using ::testing::ElementsAre;
+
+using training::readTracks;
+
+/*----------------------------------------------------------------------------*/
+/*                                  FIXTURES                                  */
+/*----------------------------------------------------------------------------*/
+
+// An empty symbol is part of the labels, so that missing labels can be read
+class ADatasetWithTracks : public testing::Test {
+ protected:
+  std::vector<config::ConverterPtr> converters {
+    std::make_shared<config::DiscreteConverter>(
+      config::option::Alphabet { "A", "C", "G", "T" }),
+    std::make_shared<config::RangeConverter>(0, 1000),
+    std::make_shared<config::DiscreteConverter>(
+      config::option::Alphabet { "", "X", "Y" }),
+  };
+};
+
+/*----------------------------------------------------------------------------*/
+/*                                   TESTS                                    */
+/*----------------------------------------------------------------------------*/
+
+TEST_F(ADatasetWithTracks, ReadsOneTrackForEachColumn) {
+  std::istringstream src("A\t0\tX\nT\t1000\tY\nG\t300\tX\n");
+  auto tracks = readTracks(src, converters);
+
+  ASSERT_THAT(tracks.size(), Eq(3u));
+  ASSERT_THAT(tracks.sequence(0), ElementsAre(0u, 3u, 2u));
+  ASSERT_THAT(tracks.sequence(1), ElementsAre(0u, 1000u, 300u));
+  ASSERT_THAT(tracks.sequence(2), ElementsAre(1u, 2u, 1u));
+}
+
+/*----------------------------------------------------------------------------*/
+
+TEST_F(ADatasetWithTracks, ReadsMissingColumnsAsEmptySymbols) {
+  std::istringstream src("A\t7\nC\t8\tY\n");
+  auto tracks = readTracks(src, converters);
+
+  ASSERT_THAT(tracks.size(), Eq(2u));
+  ASSERT_THAT(tracks.sequence(1), ElementsAre(7u, 8u));
+  ASSERT_THAT(tracks.sequence(2), ElementsAre(0u, 2u));
+}
+
+/*----------------------------------------------------------------------------*/
+
+TEST_F(ADatasetWithTracks, RejectsSymbolsOutOfTheirDomains) {
+  std::istringstream src("A\t1001\tX\n");
+  ASSERT_THROW(readTracks(src, converters), std::out_of_range);
+}
+
+/*----------------------------------------------------------------------------*/
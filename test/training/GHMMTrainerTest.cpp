@@ -0,0 +1,96 @@
+/***********************************************************************/
+/*  Copyright 2016 ToPS                                                */
+/*                                                                     */
+/*  This program is free software; you can redistribute it and/or      */
+/*  modify it under the terms of the GNU  General Public License as    */
+/*  published by the Free Software Foundation; either version 3 of     */
+/*  the License, or (at your option) any later version.                */
+/*                                                                     */
+/*  This program is distributed in the hope that it will be useful,    */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of     */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the      */
+/*  GNU General Public License for more details.                       */
+/*                                                                     */
+/*  You should have received a copy of the GNU General Public License  */
+/*  along with this program; if not, write to the Free Software        */
+/*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,         */
+/*  MA 02110-1301, USA.                                                */
+/***********************************************************************/
+
+// Standard headers
+#include <string>
+#include <fstream>
+#include <stdexcept>
+
+// Internal headers
+#include "config/Condition.hpp"
+#include "config/BasicConfig.hpp"
+#include "config/StateConfig.hpp"
+#include "config/StringLiteralSuffix.hpp"
+
+#include "training/GHMMTrainer.hpp"
+
+// External headers
+#include "gmock/gmock.h"
+
+// Using declarations
+using ::testing::Eq;
+using ::testing::DoubleEq;
+
+using config::operator ""_t;
+
+using training::GHMMTrainer;
+
+/*----------------------------------------------------------------------------*/
+/*                                  FIXTURES                                  */
+/*----------------------------------------------------------------------------*/
+
+class AGHMMTrainer : public testing::Test {
+ protected:
+  std::string dataset_path = testing::TempDir() + "ghmm_trainer.tsv";
+
+  void writeDataset(const std::string &contents) {
+    std::ofstream(dataset_path) << "observation\tlabel\n" << contents;
+  }
+};
+
+/*----------------------------------------------------------------------------*/
+/*                                   TESTS                                    */
+/*----------------------------------------------------------------------------*/
+
+TEST_F(AGHMMTrainer, CountsSegmentsOfEachLabel) {
+  writeDataset("A\tX\nA\tX\nC\tY\nA\tX\n\nC\tX\nC\tY\n");
+
+  GHMMTrainer trainer({ "A", "C" }, { "X", "Y" });
+  auto ghmm = trainer.train(dataset_path, "ghmm/model.tops");
+
+  auto &initial = std::get<decltype("initial_probabilities"_t)>(*ghmm);
+  ASSERT_THAT(initial.at(config::Condition("X")), DoubleEq(1.0));
+
+  auto &transitions
+    = std::get<decltype("transition_probabilities"_t)>(*ghmm);
+  ASSERT_THAT(transitions.at(config::Condition("Y", "X")), DoubleEq(1.0));
+  ASSERT_THAT(transitions.at(config::Condition("X", "Y")), DoubleEq(1.0));
+
+  auto &states = std::get<decltype("states"_t)>(*ghmm);
+  ASSERT_THAT(states.size(), Eq(2u));
+  ASSERT_THAT(states.count("X"), Eq(1u));
+  ASSERT_THAT(states.count("Y"), Eq(1u));
+}
+
+/*----------------------------------------------------------------------------*/
+
+TEST_F(AGHMMTrainer, RejectsLabelsWithoutSegments) {
+  writeDataset("A\tX\nC\tX\n");
+
+  GHMMTrainer trainer({ "A", "C" }, { "X", "Y" });
+  try {
+    trainer.train(dataset_path, "ghmm/model.tops");
+    FAIL() << "Expected std::logic_error";
+  } catch (const std::logic_error &e) {
+    ASSERT_THAT(std::string(e.what()),
+                ::testing::HasSubstr("No training segments for label Y"));
+  }
+}
+
+/*----------------------------------------------------------------------------*/
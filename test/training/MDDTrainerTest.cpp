@@ -0,0 +1,130 @@
+/***********************************************************************/
+/*  Copyright 2016 ToPS                                                */
+/*                                                                     */
+/*  This program is free software; you can redistribute it and/or      */
+/*  modify it under the terms of the GNU  General Public License as    */
+/*  published by the Free Software Foundation; either version 3 of     */
+/*  the License, or (at your option) any later version.                */
+/*                                                                     */
+/*  This program is distributed in the hope that it will be useful,    */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of     */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the      */
+/*  GNU General Public License for more details.                       */
+/*                                                                     */
+/*  You should have received a copy of the GNU General Public License  */
+/*  along with this program; if not, write to the Free Software        */
+/*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,         */
+/*  MA 02110-1301, USA.                                                */
+/***********************************************************************/
+
+// Standard headers
+#include <memory>
+#include <string>
+#include <vector>
+#include <stdexcept>
+
+// Internal headers
+#include "config/IIDConfig.hpp"
+#include "config/BasicConfig.hpp"
+#include "config/IMCConfig.hpp"
+#include "config/StringLiteralSuffix.hpp"
+
+#include "training/MDDTrainer.hpp"
+
+// External headers
+#include "gmock/gmock.h"
+
+// Using declarations
+using ::testing::Eq;
+using ::testing::DoubleEq;
+
+using config::operator ""_t;
+
+using training::Dataset;
+using training::MDDTrainer;
+
+/*----------------------------------------------------------------------------*/
+/*                                  FIXTURES                                  */
+/*----------------------------------------------------------------------------*/
+
+// Position 1 always follows position 0, and position 2 is independent
+// from both, so Burge's algorithm splits only on position 0
+class AnMDDTrainer : public testing::Test {
+ protected:
+  MDDTrainer trainer { { "A", "C" }, { "A", "A", "A" }, 4 };
+  Dataset training_set;
+
+  void SetUp() override {
+    for (unsigned int i = 0; i < 10; i++) {
+      training_set.push_back({ 0, 0, 0 });
+      training_set.push_back({ 0, 0, 1 });
+      training_set.push_back({ 1, 1, 0 });
+      training_set.push_back({ 1, 1, 1 });
+    }
+  }
+};
+
+/*----------------------------------------------------------------------------*/
+/*                                   TESTS                                    */
+/*----------------------------------------------------------------------------*/
+
+TEST_F(AnMDDTrainer, SplitsOnTheDependentPosition) {
+  auto mdd = trainer.train(training_set, "mdd/model.tops");
+
+  ASSERT_THAT(std::get<decltype("consensus"_t)>(*mdd), Eq("AAA"));
+  ASSERT_THAT(std::get<decltype("dependencies"_t)>(*mdd).size(), Eq(1u));
+
+  auto root = std::get<decltype("dependencies"_t)>(*mdd)[0];
+  ASSERT_THAT(std::get<decltype("position"_t)>(*root), Eq("0"));
+  ASSERT_THAT(root->children().size(), Eq(2u));
+
+  for (const auto &child : root->children()) {
+    ASSERT_THAT(std::get<decltype("position"_t)>(*child), Eq("*"));
+    ASSERT_THAT(child->children().size(), Eq(0u));
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+
+TEST_F(AnMDDTrainer, TrainsTheLeavesOnTheirSubsets) {
+  auto mdd = trainer.train(training_set, "mdd/model.tops");
+  auto root = std::get<decltype("dependencies"_t)>(*mdd)[0];
+
+  auto imc = std::dynamic_pointer_cast<config::IMCConfig>(
+    std::get<decltype("configuration"_t)>(*root->children()[0]));
+  ASSERT_THAT(imc, ::testing::NotNull());
+
+  auto &positions
+    = std::get<decltype("position_specific_distributions"_t)>(*imc);
+  ASSERT_THAT(positions.size(), Eq(3u));
+
+  auto p1 = std::dynamic_pointer_cast<config::IIDConfig>(positions[1]);
+  auto p2 = std::dynamic_pointer_cast<config::IIDConfig>(positions[2]);
+  ASSERT_THAT(std::get<decltype("emission_probabilities"_t)>(*p1)["A"],
+              DoubleEq(1.0));
+  ASSERT_THAT(std::get<decltype("emission_probabilities"_t)>(*p2)["A"],
+              DoubleEq(0.5));
+}
+
+/*----------------------------------------------------------------------------*/
+
+TEST(MDDTrainer, RejectsAnEmptyConsensus) {
+  ASSERT_THROW(MDDTrainer({ "A", "C" }, {}, 4), std::invalid_argument);
+}
+
+/*----------------------------------------------------------------------------*/
+
+TEST(MDDTrainer, RejectsAConsensusOutOfTheAlphabet) {
+  ASSERT_THROW(MDDTrainer({ "A", "C" }, { "A", "G" }, 4),
+               std::invalid_argument);
+}
+
+/*----------------------------------------------------------------------------*/
+
+TEST_F(AnMDDTrainer, RejectsSymbolsOutOfTheAlphabet) {
+  training_set.push_back({ 0, 2, 0 });
+  ASSERT_THROW(trainer.train(training_set, "mdd/model.tops"),
+               std::logic_error);
+}
+
+/*----------------------------------------------------------------------------*/